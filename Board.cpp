@@ -1,91 +1,151 @@
 #include "include/Board.h"
+#include "include/ResourceCache.h"
+#include "include/Log.h"
 #include <fstream>
-#include <iostream>
 #include <algorithm> // for std::remove
+#include <cmath>
 
-Board::Board(const std::string& path) {
+Board::Board(const std::string& path, bool mergeCollidables)
+    : m_gridColumns(0),
+      m_gridRows(0),
+      m_mergeCollidables(mergeCollidables)
+{
     loadMap(path);
-    loadImages();
     generateCollidables();
 }
 
 void Board::loadMap(const std::string& path) {
+    m_tiles.clear();
+    m_gridColumns = 0;
+    m_gridRows = 0;
+
     std::ifstream file(path);
     if (!file.is_open()) {
-        std::cerr << "CRITICAL FAILED: Could not open map file: " << path << std::endl;
-        // Load a dummy map so the game doesn't crash
-        m_gameMap.resize(30, std::vector<std::string>(40, "0"));
+        LOG_ERROR(LogCategory::Level, "Could not open map file: " << path);
+        // Load a dummy one-screen map so the game doesn't crash
+        m_gridColumns = 40;
+        m_gridRows = 30;
+        m_tiles.assign(static_cast<size_t>(m_gridRows) * m_gridColumns, Tiles::EMPTY);
         return;
     }
 
-    std::cout << "Loading map: " << path << std::endl;
+    LOG_DEBUG(LogCategory::Level, "Loading map: " << path);
     std::string line;
 
+    // Rows go in back to back first; the map is as wide as its widest row
+    std::vector<size_t> rowEnds;
+
     while (std::getline(file, line)) {
         // Remove carriage returns
         line.erase(std::remove(line.begin(), line.end(), '\r'), line.end());
 
         if (line.empty()) continue;
 
-        std::vector<std::string> row;
-        std::string cell;
-
         // Manual parsing of comma-separated values
-        for (char c : line) {
-            if (c == ',') {
-                row.push_back(cell);
-                cell.clear();
-            } else {
-                cell += c;
-            }
-        }
-        // Push the last cell
-        row.push_back(cell);
-
-        // Normalize row length to exactly 40 columns
-        if (row.size() < 40) {
-            row.resize(40, "0");   // pad with empty tiles
-        } else if (row.size() > 40) {
-            row.resize(40);        // truncate extras
+        size_t rowStart = m_tiles.size();
+        std::string_view cells(line);
+        while (true) {
+            size_t comma = cells.find(',');
+            m_tiles.push_back(Tiles::parseTileCode(cells.substr(0, comma)));
+
+            if (comma == std::string_view::npos) break;
+            cells.remove_prefix(comma + 1);
         }
 
-        m_gameMap.push_back(row);
+        rowEnds.push_back(m_tiles.size());
+        m_gridColumns = std::max(m_gridColumns, static_cast<int>(m_tiles.size() - rowStart));
+        ++m_gridRows;
     }
 
     file.close();
 
-    std::cout << "Map loaded successfully. Rows: " << m_gameMap.size();
-    if (!m_gameMap.empty()) {
-        std::cout << ", Columns in first row: " << m_gameMap[0].size();
+    // Ragged rows: pad the short ones with empty tiles
+    if (m_tiles.size() != static_cast<size_t>(m_gridRows) * m_gridColumns) {
+        std::vector<TileId> padded(static_cast<size_t>(m_gridRows) * m_gridColumns, Tiles::EMPTY);
+        size_t rowStart = 0;
+        for (int y = 0; y < m_gridRows; ++y) {
+            std::copy(m_tiles.begin() + rowStart, m_tiles.begin() + rowEnds[y],
+                      padded.begin() + static_cast<size_t>(y) * m_gridColumns);
+            rowStart = rowEnds[y];
+        }
+        m_tiles.swap(padded);
     }
-    std::cout << std::endl;
+
+    LOG_DEBUG(LogCategory::Level, "Map loaded successfully. Rows: " << m_gridRows
+              << ", Columns: " << m_gridColumns);
 }
 
-void Board::loadImages() {
-    // Background texture
-    sf::Texture backgroundTexture;
-    if (backgroundTexture.loadFromFile("data/board_textures/wall.png")) {
-        m_textures["background"] = backgroundTexture;
-    } else {
-        std::cerr << "Warning: background texture not found." << std::endl;
-    }
+namespace {
+
+const char* const BACKGROUND_IMAGE = "data/board_textures/wall.png";
+
+std::string tileImagePath(const TileProperties& tile) {
+    return "data/board_textures/" + std::string(tile.code) + ".png";
+}
 
-    // Tile textures
-    std::vector<std::string> textureNames = {
-        "100", "111", "112", "113", "114",
-        "121", "122", "123", "124",
-        "2", "3", "4"
-    };
-
-    for (const auto& name : textureNames) {
-        sf::Texture texture;
-        std::string path = "data/board_textures/" + name + ".png";
-        if (texture.loadFromFile(path)) {
-            m_textures[name] = texture;
+// Tile textures are packed side by side into one atlas so the whole board
+// can be drawn with a single texture bind.
+bool buildTileAtlas(TileAtlas& atlas) {
+    const unsigned int chunk = Board::CHUNK_SIZE;
+
+    std::vector<std::pair<TileId, std::shared_ptr<const sf::Image>>> images;
+    unsigned int atlasWidth = chunk;   // first cell is the blank one
+    unsigned int atlasHeight = chunk;
+
+    for (size_t id = 0; id < Tiles::COUNT; ++id) {
+        const TileProperties& tile = Tiles::PROPERTIES[id];
+        if (!tile.textured) continue;
+
+        // Possibly decoded ahead of time; only needed until it is packed
+        std::string path = tileImagePath(tile);
+        std::shared_ptr<const sf::Image> image = ImageCache::instance().get(path);
+        ImageCache::instance().release(path);
+        if (image->getSize().x > 0) {
+            atlasWidth += image->getSize().x;
+            atlasHeight = std::max(atlasHeight, image->getSize().y);
+            images.emplace_back(static_cast<TileId>(id), std::move(image));
         } else {
-            std::cerr << "Warning: texture not found for tile " << name << std::endl;
+            LOG_WARNING(LogCategory::Resource, "texture not found for tile " << tile.code);
         }
     }
+
+    sf::Image atlasImage(sf::Vector2u(atlasWidth, atlasHeight), sf::Color::Transparent);
+    for (unsigned int y = 0; y < chunk; ++y) {
+        for (unsigned int x = 0; x < chunk; ++x) {
+            atlasImage.setPixel(sf::Vector2u(x, y), sf::Color::White);
+        }
+    }
+    atlas.blankRect = sf::IntRect(sf::Vector2i(0, 0), sf::Vector2i(chunk, chunk));
+
+    unsigned int offsetX = chunk;
+    for (const auto& [id, image] : images) {
+        if (!atlasImage.copy(*image, sf::Vector2u(offsetX, 0))) {
+            LOG_WARNING(LogCategory::Resource, "could not pack tile " << Tiles::properties(id).code << " into atlas");
+            continue;
+        }
+        atlas.rects[id] = sf::IntRect(sf::Vector2i(static_cast<int>(offsetX), 0),
+                                      sf::Vector2i(static_cast<int>(image->getSize().x),
+                                                   static_cast<int>(image->getSize().y)));
+        offsetX += image->getSize().x;
+    }
+
+    return atlas.texture.loadFromImage(atlasImage);
+}
+
+}
+
+// Shared through the resource caches, so a restart reuses the GPU textures
+void Board::loadImages() {
+    m_background = TextureCache::instance().get(BACKGROUND_IMAGE);
+    m_tileAtlas = ResourceCache<TileAtlas>::instance().get("board_tiles", buildTileAtlas);
+}
+
+std::vector<std::string> Board::getImagePaths() {
+    std::vector<std::string> paths = {BACKGROUND_IMAGE};
+    for (const TileProperties& tile : Tiles::PROPERTIES) {
+        if (tile.textured) paths.push_back(tileImagePath(tile));
+    }
+    return paths;
 }
 
 void Board::generateCollidables() {
@@ -94,33 +154,153 @@ void Board::generateCollidables() {
     m_waterPools.clear();
     m_gooPools.clear();
 
-    for (size_t y = 0; y < m_gameMap.size(); ++y) {
-        for (size_t x = 0; x < m_gameMap[y].size(); ++x) {
-            const std::string& tile = m_gameMap[y][x];
+    // Hazard bits per cell, for hazardsOverlapping()
+    m_hazardMask.resize(m_tiles.size());
+    for (size_t i = 0; i < m_tiles.size(); ++i) {
+        m_hazardMask[i] = Tiles::properties(m_tiles[i]).flags & TILE_HAZARD;
+    }
+
+    if (m_mergeCollidables) {
+        mergeSolidBlocks();
+        mergeHazardRuns(Tiles::LAVA, m_lavaPools);
+        mergeHazardRuns(Tiles::WATER, m_waterPools);
+        mergeHazardRuns(Tiles::GOO, m_gooPools);
+    } else {
+        for (int y = 0; y < m_gridRows; ++y) {
+            for (int x = 0; x < m_gridColumns; ++x) {
+                const std::uint8_t flags = Tiles::properties(getTile(x, y)).flags;
+                if (!flags) continue;
 
-            sf::Vector2f pos(static_cast<float>(x * CHUNK_SIZE), static_cast<float>(y * CHUNK_SIZE));
-            sf::Vector2f fullSize(static_cast<float>(CHUNK_SIZE), static_cast<float>(CHUNK_SIZE));
-            sf::Vector2f halfSize(static_cast<float>(CHUNK_SIZE), static_cast<float>(CHUNK_SIZE / 2.0f));
-            sf::Vector2f lowerHalfPos(pos.x, pos.y + CHUNK_SIZE / 2.0f);
+                sf::Vector2f pos(static_cast<float>(x * CHUNK_SIZE), static_cast<float>(y * CHUNK_SIZE));
+                sf::Vector2f fullSize(static_cast<float>(CHUNK_SIZE), static_cast<float>(CHUNK_SIZE));
+                sf::Vector2f halfSize(static_cast<float>(CHUNK_SIZE), static_cast<float>(CHUNK_SIZE / 2.0f));
+                sf::Vector2f lowerHalfPos(pos.x, pos.y + CHUNK_SIZE / 2.0f);
 
-            // Solid blocks: everything except empty (0) and hazards (2,3,4)
-            if (tile != "0" && tile != "2" && tile != "3" && tile != "4" && !tile.empty()) {
-                m_solidBlocks.emplace_back(pos, fullSize);
+                if (flags & TILE_SOLID) m_solidBlocks.emplace_back(pos, fullSize);
+
+                // Hazards: use lower half of tile
+                if (flags & TILE_LAVA) m_lavaPools.emplace_back(lowerHalfPos, halfSize);
+                if (flags & TILE_WATER) m_waterPools.emplace_back(lowerHalfPos, halfSize);
+                if (flags & TILE_GOO) m_gooPools.emplace_back(lowerHalfPos, halfSize);
+            }
+        }
+    }
+
+    LOG_DEBUG(LogCategory::Physics, "Generated " << m_solidBlocks.size() << " solid blocks.");
+}
+
+// Greedy maximal rectangles over the solid grid: grow a horizontal run from
+// the first unvisited solid cell, then extend it down while the whole run
+// below is still solid and unvisited.
+void Board::mergeSolidBlocks() {
+    std::vector<unsigned char> visited(m_tiles.size(), 0);
+    const float chunk = static_cast<float>(CHUNK_SIZE);
+
+    for (int y = 0; y < m_gridRows; ++y) {
+        for (int x = 0; x < m_gridColumns; ++x) {
+            size_t start = static_cast<size_t>(y) * m_gridColumns + x;
+            if (!isSolidCell(x, y) || visited[start]) continue;
+
+            int width = 1;
+            while (x + width < m_gridColumns && isSolidCell(x + width, y) && !visited[start + width]) {
+                ++width;
             }
 
-            // Hazards: use lower half of tile
-            if (tile == "2") m_lavaPools.emplace_back(lowerHalfPos, halfSize);
-            if (tile == "3") m_waterPools.emplace_back(lowerHalfPos, halfSize);
-            if (tile == "4") m_gooPools.emplace_back(lowerHalfPos, halfSize);
+            int height = 1;
+            while (y + height < m_gridRows) {
+                size_t rowStart = static_cast<size_t>(y + height) * m_gridColumns + x;
+                bool fullRun = true;
+                for (int i = 0; i < width; ++i) {
+                    if (!isSolidCell(x + i, y + height) || visited[rowStart + i]) {
+                        fullRun = false;
+                        break;
+                    }
+                }
+                if (!fullRun) break;
+                ++height;
+            }
+
+            for (int dy = 0; dy < height; ++dy) {
+                size_t rowStart = static_cast<size_t>(y + dy) * m_gridColumns + x;
+                std::fill(visited.begin() + rowStart, visited.begin() + rowStart + width, 1);
+            }
+
+            m_solidBlocks.emplace_back(sf::Vector2f(x * chunk, y * chunk),
+                                       sf::Vector2f(width * chunk, height * chunk));
         }
     }
+}
+
+// Hazards only fill the lower half of a tile, so vertically stacked pools
+// are not contiguous; only horizontal runs can be merged.
+void Board::mergeHazardRuns(TileId hazardTile, std::vector<sf::FloatRect>& pools) {
+    const float chunk = static_cast<float>(CHUNK_SIZE);
+
+    for (int y = 0; y < m_gridRows; ++y) {
+        int x = 0;
+        while (x < m_gridColumns) {
+            if (getTile(x, y) != hazardTile) {
+                ++x;
+                continue;
+            }
 
-    std::cout << "Generated " << m_solidBlocks.size() << " solid blocks." << std::endl;
+            int runStart = x;
+            while (x < m_gridColumns && getTile(x, y) == hazardTile) ++x;
+
+            pools.emplace_back(sf::Vector2f(runStart * chunk, y * chunk + chunk / 2.0f),
+                               sf::Vector2f((x - runStart) * chunk, chunk / 2.0f));
+        }
+    }
 }
 
 const std::vector<sf::FloatRect>& Board::getSolidBlocks() const { return m_solidBlocks; }
 const std::vector<sf::FloatRect>& Board::getLavaPools() const { return m_lavaPools; }
 const std::vector<sf::FloatRect>& Board::getWaterPools() const { return m_waterPools; }
 const std::vector<sf::FloatRect>& Board::getGooPools() const { return m_gooPools; }
-const std::map<std::string, sf::Texture>& Board::getTextures() const { return m_textures; }
-const std::vector<std::vector<std::string>>& Board::getGameMap() const { return m_gameMap; }
+const sf::Texture* Board::getBackground() const { return m_background.get(); }
+const TileAtlas* Board::getTileAtlas() const { return m_tileAtlas.get(); }
+const std::vector<TileId>& Board::getTiles() const { return m_tiles; }
+
+// Same answer as intersecting rect with every pool rect: a hazard fills the
+// lower half of its cell, and only a strictly positive overlap counts.
+std::uint8_t Board::hazardsOverlapping(const sf::FloatRect& rect) const {
+    const float chunk = static_cast<float>(CHUNK_SIZE);
+    const float left = rect.position.x;
+    const float top = rect.position.y;
+    const float right = left + rect.size.x;
+    const float bottom = top + rect.size.y;
+
+    int firstColumn = std::max(0, static_cast<int>(std::floor(left / chunk)));
+    int lastColumn = std::min(m_gridColumns, static_cast<int>(std::ceil(right / chunk)));
+    int firstRow = std::max(0, static_cast<int>(std::floor(top / chunk)));
+    int lastRow = std::min(m_gridRows, static_cast<int>(std::ceil(bottom / chunk)));
+
+    std::uint8_t hazards = 0;
+    for (int y = firstRow; y < lastRow; ++y) {
+        // Cell rows overlap by construction; the hazard's top is mid-cell
+        if (y * chunk + chunk / 2.0f >= bottom) continue;
+
+        const std::uint8_t* row = m_hazardMask.data() + static_cast<size_t>(y) * m_gridColumns;
+        for (int x = firstColumn; x < lastColumn; ++x) {
+            hazards |= row[x];
+        }
+    }
+    return hazards;
+}
+
+TileId Board::getTile(int column, int row) const {
+    if (column < 0 || row < 0 || column >= m_gridColumns || row >= m_gridRows) return Tiles::EMPTY;
+    return m_tiles[static_cast<size_t>(row) * m_gridColumns + column];
+}
+
+bool Board::isSolidCell(int column, int row) const {
+    return Tiles::hasFlag(getTile(column, row), TILE_SOLID);
+}
+
+int Board::getGridColumns() const { return m_gridColumns; }
+int Board::getGridRows() const { return m_gridRows; }
+
+sf::Vector2f Board::getWorldSize() const {
+    return sf::Vector2f(static_cast<float>(m_gridColumns * CHUNK_SIZE),
+                        static_cast<float>(m_gridRows * CHUNK_SIZE));
+}
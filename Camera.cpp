@@ -0,0 +1,47 @@
+#include "include/Camera.h"
+#include <algorithm>
+
+Camera::Camera(const sf::Vector2f& screenSize)
+    : m_view(screenSize / 2.0f, screenSize),
+      m_screenSize(screenSize)
+{
+}
+
+void Camera::follow(const std::vector<sf::FloatRect>& targets, const sf::Vector2f& worldSize) {
+    if (targets.empty()) return;   // nobody left to follow, hold still
+
+    sf::Vector2f low = targets.front().position;
+    sf::Vector2f high = low + targets.front().size;
+    for (const auto& target : targets) {
+        low.x = std::min(low.x, target.position.x);
+        low.y = std::min(low.y, target.position.y);
+        high.x = std::max(high.x, target.position.x + target.size.x);
+        high.y = std::max(high.y, target.position.y + target.size.y);
+    }
+
+    // Smallest zoom at screen aspect that fits everyone plus a margin, but
+    // never so far out that the view is bigger than the level
+    sf::Vector2f needed = (high - low) + sf::Vector2f(MARGIN, MARGIN) * 2.0f;
+    float zoom = std::max({1.0f, needed.x / m_screenSize.x, needed.y / m_screenSize.y});
+    float levelZoom = std::min(worldSize.x / m_screenSize.x, worldSize.y / m_screenSize.y);
+    zoom = std::min({zoom, MAX_ZOOM, std::max(1.0f, levelZoom)});
+    sf::Vector2f size = m_screenSize * zoom;
+
+    // Keep the view inside the level on each axis that is big enough
+    sf::Vector2f centre = (low + high) / 2.0f;
+    auto clampAxis = [](float target, float viewSize, float levelSize) {
+        if (levelSize <= viewSize) return levelSize / 2.0f;
+        return std::clamp(target, viewSize / 2.0f, levelSize - viewSize / 2.0f);
+    };
+    centre.x = clampAxis(centre.x, size.x, worldSize.x);
+    centre.y = clampAxis(centre.y, size.y, worldSize.y);
+
+    m_view.setSize(size);
+    m_view.setCenter(centre);
+}
+
+const sf::View& Camera::getView() const { return m_view; }
+
+sf::FloatRect Camera::getVisibleArea() const {
+    return sf::FloatRect(m_view.getCenter() - m_view.getSize() / 2.0f, m_view.getSize());
+}
@@ -1,20 +1,129 @@
 #include "include/Character.h"
 #include "include/Board.h"
-#include <iostream>
+#include "include/ResourceCache.h"
+#include "include/Log.h"
+#include "include/LevelCheck.h"
 #include <cmath>
 
-Character::Character(const sf::Vector2f& pos)
+namespace {
+
+enum class Axis { X, Y };
+
+// Swept move of `rect` by `delta` along one axis against the board's solid
+// cells and the extra solid rects. Returns where the rect's leading edge
+// ends up: the first edge it would cross, or start + delta if nothing is
+// in the way. Cells are walked from the leading edge outwards and the first
+// solid line ends the search, so a step of any length stops at the first
+// wall instead of skipping thin ones. Anything the rect already overlaps is
+// ignored here; see pushOut().
+struct Sweep {
+    float position;   // new rect.position along the axis
+    bool blocked;
+};
+
+Sweep sweep(const sf::FloatRect& rect, float delta, Axis axis, const Board& board,
+            const std::vector<sf::FloatRect>& obstacles) {
+    const float chunk = static_cast<float>(Board::CHUNK_SIZE);
+    const bool alongX = (axis == Axis::X);
+
+    const float start = alongX ? rect.position.x : rect.position.y;
+    const float size = alongX ? rect.size.x : rect.size.y;
+    const float crossStart = alongX ? rect.position.y : rect.position.x;
+    const float crossEnd = crossStart + (alongX ? rect.size.y : rect.size.x);
+    const bool forward = delta > 0.0f;
+    const float leading = forward ? start + size : start;
+    const float target = leading + delta;
+
+    // Nearest edge crossed so far (in the direction of travel)
+    bool blocked = false;
+    float contact = target;
+
+    // Rows (or columns) the rect covers with positive extent
+    const int firstCross = static_cast<int>(std::floor(crossStart / chunk));
+    const int lastCross = static_cast<int>(std::ceil(crossEnd / chunk)) - 1;
+    auto lineIsSolid = [&](int line) {
+        for (int cross = firstCross; cross <= lastCross; ++cross) {
+            if (alongX ? board.isSolidCell(line, cross) : board.isSolidCell(cross, line)) return true;
+        }
+        return false;
+    };
+
+    if (forward) {
+        const int lastLine = static_cast<int>(std::ceil(target / chunk)) - 1;
+        for (int line = static_cast<int>(std::ceil(leading / chunk)); line <= lastLine; ++line) {
+            if (lineIsSolid(line)) {
+                contact = line * chunk;
+                blocked = true;
+                break;
+            }
+        }
+    } else {
+        const int lastLine = static_cast<int>(std::floor(target / chunk));
+        for (int line = static_cast<int>(std::floor(leading / chunk)) - 1; line >= lastLine; --line) {
+            if (lineIsSolid(line)) {
+                contact = (line + 1) * chunk;
+                blocked = true;
+                break;
+            }
+        }
+    }
+
+    for (const auto& obstacle : obstacles) {
+        const float obstacleStart = alongX ? obstacle.position.x : obstacle.position.y;
+        const float obstacleEnd = obstacleStart + (alongX ? obstacle.size.x : obstacle.size.y);
+        const float obstacleCrossStart = alongX ? obstacle.position.y : obstacle.position.x;
+        const float obstacleCrossEnd = obstacleCrossStart + (alongX ? obstacle.size.y : obstacle.size.x);
+        if (obstacleCrossEnd <= crossStart || crossEnd <= obstacleCrossStart) continue;
+
+        if (forward && obstacleStart >= leading && obstacleStart < contact) {
+            contact = obstacleStart;
+            blocked = true;
+        } else if (!forward && obstacleEnd <= leading && obstacleEnd > contact) {
+            contact = obstacleEnd;
+            blocked = true;
+        }
+    }
+
+    // Placed from the contact edge itself so the rect sits exactly against
+    // it and the next sweep starts flush, with no rounding drift
+    if (!blocked) return Sweep{start + delta, false};
+    return Sweep{forward ? contact - size : contact, true};
+}
+
+// Obstacles can appear on top of a character (a gate closing on it):
+// push it out along whichever axis needs the smaller move
+void pushOut(sf::FloatRect& rect, const std::vector<sf::FloatRect>& obstacles) {
+    for (const auto& obstacle : obstacles) {
+        auto intersection = rect.findIntersection(obstacle);
+        if (!intersection) continue;
+
+        const sf::FloatRect& overlap = *intersection;
+        if (overlap.size.x < overlap.size.y) {
+            rect.position.x += (rect.position.x < obstacle.position.x) ? -overlap.size.x : overlap.size.x;
+        } else {
+            rect.position.y += (rect.position.y < obstacle.position.y) ? -overlap.size.y : overlap.size.y;
+        }
+    }
+}
+
+}
+
+Character::Character(CharacterKind kind, const sf::Vector2f& pos)
     : m_isAlive(true),
       m_yVelocity(0.0f),
       m_isJumping(false),
       m_movingRight(false),
       m_movingLeft(false),
-      m_airTimer(0)
+      m_airTimer(0),
+      m_kind(kind),
+      m_lethalHazards(kind == CharacterKind::Hot ? TILE_WATER | TILE_GOO : TILE_LAVA | TILE_GOO)
 {
-    m_rect = sf::FloatRect(pos, sf::Vector2f(16.0f, 32.0f));
+    m_rect = sf::FloatRect(pos, sf::Vector2f(LevelCheck::PLAYER_WIDTH, LevelCheck::PLAYER_HEIGHT));
+    m_previousPosition = pos;
 }
 
-void Character::update(Board& board) {
+// `obstacles` are solid rects on top of the board's grid (closed gates)
+void Character::update(const Board& board, const std::vector<sf::FloatRect>& obstacles) {
     if (!m_isAlive) return;
 
     const float SPEED = 3.0f;
@@ -36,42 +145,21 @@ void Character::update(Board& board) {
     if (m_yVelocity > MAX_FALL_SPEED) m_yVelocity = MAX_FALL_SPEED;
     velocity.y = m_yVelocity;
 
-    // X AXIS MOVEMENT
-    m_rect.position.x += velocity.x;
-
-    const auto& solidBlocks = board.getSolidBlocks();
-    for (const auto& block : solidBlocks) {
-        if (auto intersection = m_rect.findIntersection(block)) {
-            sf::FloatRect overlap = *intersection;
+    // One solver for the grid and the obstacles: x first, then y, each
+    // stopping at the first contact however far the step goes
+    pushOut(m_rect, obstacles);
 
-            if (overlap.size.x < overlap.size.y) {
-                if (m_rect.position.x < block.position.x) {
-                    m_rect.position.x -= overlap.size.x;
-                } else {
-                    m_rect.position.x += overlap.size.x;
-                }
-            }
-        }
+    if (velocity.x != 0.0f) {
+        m_rect.position.x = sweep(m_rect, velocity.x, Axis::X, board, obstacles).position;
     }
 
-    // Y AXIS MOVEMENT
-    m_rect.position.y += velocity.y;
-
     bool onGround = false;
-    for (const auto& block : solidBlocks) {
-        if (auto intersection = m_rect.findIntersection(block)) {
-            sf::FloatRect overlap = *intersection;
-
-            if (overlap.size.x > overlap.size.y) {
-                if (m_rect.position.y < block.position.y) {
-                    m_rect.position.y -= overlap.size.y;
-                    m_yVelocity = 0.0f;
-                    onGround = true;
-                } else {
-                    m_rect.position.y += overlap.size.y;
-                    m_yVelocity = 0.0f;
-                }
-            }
+    if (velocity.y != 0.0f) {
+        Sweep vertical = sweep(m_rect, velocity.y, Axis::Y, board, obstacles);
+        m_rect.position.y = vertical.position;
+        if (vertical.blocked) {
+            m_yVelocity = 0.0f;
+            onGround = velocity.y > 0.0f;
         }
     }
 
@@ -82,24 +170,63 @@ void Character::update(Board& board) {
     }
 }
 
-void Character::calcMovement() {}
-void Character::handleCollisions(Board& board) {}
+namespace {
+const char* const HOT_IMAGE = "data/player_images/magmaboy.png";
+const char* const COLD_IMAGE = "data/player_images/hydrogirl.png";
+}
+
+// Sprite only; the hitbox stays 16x32 so headless runs collide identically
+void Character::loadImages() {
+    m_texture = TextureCache::instance().get(m_kind == CharacterKind::Hot ? HOT_IMAGE : COLD_IMAGE);
+    m_sprite.emplace(*m_texture);
+}
+
+std::vector<std::string> Character::getImagePaths() {
+    return {HOT_IMAGE, COLD_IMAGE};
+}
 
-void Character::draw(sf::RenderWindow& window) {
+// alpha is how far the renderer is between the previous tick and this one
+void Character::draw(sf::RenderTarget& target, float alpha) {
     if (!m_isAlive || !m_sprite) return;
 
-    m_sprite->setPosition(m_rect.position);
-    window.draw(*m_sprite);
+    m_sprite->setPosition(getInterpolatedPosition(alpha));
+    target.draw(*m_sprite);
+}
+
+sf::Vector2f Character::getInterpolatedPosition(float alpha) const {
+    return m_previousPosition + (m_rect.position - m_previousPosition) * alpha;
 }
 
 void Character::kill() {
     m_isAlive = false;
-    std::cout << m_type << " player died!" << std::endl;
+    LOG_INFO(LogCategory::Physics, getType() << " player died!");
+}
+
+void Character::storePreviousPosition() {
+    m_previousPosition = m_rect.position;
+}
+
+Character::State Character::saveState() const {
+    return State{m_rect, m_previousPosition, m_yVelocity, m_airTimer,
+                 m_isAlive, m_isJumping, m_movingRight, m_movingLeft};
+}
+
+void Character::restoreState(const State& state) {
+    m_rect = state.rect;
+    m_previousPosition = state.previousPosition;
+    m_yVelocity = state.yVelocity;
+    m_airTimer = state.airTimer;
+    m_isAlive = state.isAlive;
+    m_isJumping = state.isJumping;
+    m_movingRight = state.movingRight;
+    m_movingLeft = state.movingLeft;
 }
 
 bool Character::isDead() const { return !m_isAlive; }
 sf::FloatRect Character::getRect() const { return m_rect; }
-std::string Character::getType() const { return m_type; }
+CharacterKind Character::getKind() const { return m_kind; }
+std::string Character::getType() const { return m_kind == CharacterKind::Hot ? "hot" : "cold"; }
+std::uint8_t Character::getLethalHazards() const { return m_lethalHazards; }
 
 // NEW METHODS FOR GATE COLLISION
 void Character::setPosition(const sf::Vector2f& pos) {
@@ -114,30 +241,6 @@ void Character::setMovingRight(bool moving) { m_movingRight = moving; }
 void Character::setMovingLeft(bool moving) { m_movingLeft = moving; }
 void Character::setJumping(bool jumping) { m_isJumping = jumping; }
 
-Hot::Hot(const sf::Vector2f& pos) : Character(pos) {
-    m_type = "hot";
-    if (m_texture.loadFromFile("data/player_images/magmaboy.png")) {
-        // loaded
-    }
-    m_sprite.emplace(m_texture);
-
-    if (m_texture.getSize().x > 0) {
-        m_rect.size = sf::Vector2f(static_cast<float>(m_texture.getSize().x),
-                                   static_cast<float>(m_texture.getSize().y));
-    }
-}
-void Hot::update(Board& board) { Character::update(board); }
-
-Cold::Cold(const sf::Vector2f& pos) : Character(pos) {
-    m_type = "cold";
-    if (m_texture.loadFromFile("data/player_images/hydrogirl.png")) {
-        // loaded
-    }
-    m_sprite.emplace(m_texture);
-
-    if (m_texture.getSize().x > 0) {
-        m_rect.size = sf::Vector2f(static_cast<float>(m_texture.getSize().x),
-                                   static_cast<float>(m_texture.getSize().y));
-    }
-}
-void Cold::update(Board& board) { Character::update(board); }
+bool Character::isMovingRight() const { return m_movingRight; }
+bool Character::isMovingLeft() const { return m_movingLeft; }
+bool Character::isJumping() const { return m_isJumping; }
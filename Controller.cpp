@@ -1,69 +1,363 @@
 #include "include/Controller.h"
+#include "include/Replay.h"
+#include "include/Log.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
 
-// ArrowsController - Controls Hot Player
-void ArrowsController::controlPlayer(const sf::Event& event, Character& player) {
-    if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
-        switch (keyPressed->code) {
-            case sf::Keyboard::Key::Right:
-                player.setMovingRight(true);
-                break;
-            case sf::Keyboard::Key::Left:
-                player.setMovingLeft(true);
-                break;
-            case sf::Keyboard::Key::Up:
-                player.setJumping(true);
-                break;
-            default:
-                break;
+namespace {
+
+using Key = sf::Keyboard::Key;
+using Axis = sf::Joystick::Axis;
+
+const char* const ACTION_NAMES[] = {"hot_right", "hot_left", "hot_jump", "cold_right", "cold_left", "cold_jump"};
+
+const std::uint8_t ACTION_BITS[] = {
+    Replay::HOT_RIGHT, Replay::HOT_LEFT, Replay::HOT_JUMP,
+    Replay::COLD_RIGHT, Replay::COLD_LEFT, Replay::COLD_JUMP
+};
+
+const std::uint8_t JUMP_BITS = Replay::HOT_JUMP | Replay::COLD_JUMP;
+
+struct KeyName {
+    const char* name;
+    Key key;
+};
+
+// Named as in sf::Keyboard::Key. Letters, Num0-9, Numpad0-9 and F1-F15
+// are worked out from their first entry instead.
+const KeyName KEY_NAMES[] = {
+    {"Escape", Key::Escape}, {"LControl", Key::LControl}, {"LShift", Key::LShift}, {"LAlt", Key::LAlt},
+    {"LSystem", Key::LSystem}, {"RControl", Key::RControl}, {"RShift", Key::RShift}, {"RAlt", Key::RAlt},
+    {"RSystem", Key::RSystem}, {"Menu", Key::Menu}, {"LBracket", Key::LBracket}, {"RBracket", Key::RBracket},
+    {"Semicolon", Key::Semicolon}, {"Comma", Key::Comma}, {"Period", Key::Period},
+    {"Apostrophe", Key::Apostrophe}, {"Slash", Key::Slash}, {"Backslash", Key::Backslash},
+    {"Grave", Key::Grave}, {"Equal", Key::Equal}, {"Hyphen", Key::Hyphen}, {"Space", Key::Space},
+    {"Enter", Key::Enter}, {"Backspace", Key::Backspace}, {"Tab", Key::Tab}, {"PageUp", Key::PageUp},
+    {"PageDown", Key::PageDown}, {"End", Key::End}, {"Home", Key::Home}, {"Insert", Key::Insert},
+    {"Delete", Key::Delete}, {"Add", Key::Add}, {"Subtract", Key::Subtract}, {"Multiply", Key::Multiply},
+    {"Divide", Key::Divide}, {"Left", Key::Left}, {"Right", Key::Right}, {"Up", Key::Up},
+    {"Down", Key::Down}, {"Pause", Key::Pause}
+};
+
+struct KeyRange {
+    const char* prefix;
+    Key first;
+    int count;
+    int firstNumber;
+};
+
+const KeyRange KEY_RANGES[] = {
+    {"Num", Key::Num0, 10, 0},
+    {"Numpad", Key::Numpad0, 10, 0},
+    {"F", Key::F1, 15, 1}
+};
+
+// Game commands (Game, ResultsScene); binding them to a player too would
+// quit or restart mid-move
+const Key RESERVED_KEYS[] = {Key::Escape, Key::R, Key::M, Key::F3};
+
+bool isReserved(const Controller::Binding& binding) {
+    return binding.type == Controller::Binding::Type::Key &&
+           std::find(std::begin(RESERVED_KEYS), std::end(RESERVED_KEYS), binding.key) != std::end(RESERVED_KEYS);
+}
+
+const char* const AXIS_NAMES[] = {"X", "Y", "Z", "R", "U", "V", "PovX", "PovY"};
+
+bool equalsIgnoringCase(std::string_view a, std::string_view b) {
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+               return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+           });
+}
+
+bool startsWithIgnoringCase(std::string_view text, std::string_view prefix) {
+    return text.size() >= prefix.size() && equalsIgnoringCase(text.substr(0, prefix.size()), prefix);
+}
+
+// Whole string as a number below `limit`
+bool parseNumber(std::string_view text, unsigned int limit, unsigned int& value) {
+    if (text.empty() || text.size() > 3) return false;
+    value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') return false;
+        value = value * 10 + static_cast<unsigned int>(c - '0');
+    }
+    return value < limit;
+}
+
+bool parseKey(std::string_view text, Key& key) {
+    if (text.size() == 1 && std::isalpha(static_cast<unsigned char>(text[0]))) {
+        int offset = std::toupper(static_cast<unsigned char>(text[0])) - 'A';
+        key = static_cast<Key>(static_cast<int>(Key::A) + offset);
+        return true;
+    }
+    for (const KeyName& entry : KEY_NAMES) {
+        if (equalsIgnoringCase(text, entry.name)) {
+            key = entry.key;
+            return true;
         }
     }
-    else if (const auto* keyReleased = event.getIf<sf::Event::KeyReleased>()) {
-        switch (keyReleased->code) {
-            case sf::Keyboard::Key::Right:
-                player.setMovingRight(false);
-                break;
-            case sf::Keyboard::Key::Left:
-                player.setMovingLeft(false);
-                break;
-            case sf::Keyboard::Key::Up:
-                player.setJumping(false);
-                break;
-            default:
-                break;
+    // Longest prefix first, so "Numpad1" is not read as "Num" + "pad1"
+    for (auto range = std::rbegin(KEY_RANGES); range != std::rend(KEY_RANGES); ++range) {
+        std::string_view prefix(range->prefix);
+        unsigned int number = 0;
+        if (!startsWithIgnoringCase(text, prefix) ||
+            !parseNumber(text.substr(prefix.size()), static_cast<unsigned int>(range->firstNumber + range->count), number) ||
+            static_cast<int>(number) < range->firstNumber) {
+            continue;
         }
+        key = static_cast<Key>(static_cast<int>(range->first) + static_cast<int>(number) - range->firstNumber);
+        return true;
     }
+    return false;
 }
 
-// WASDController - Controls Cold Player
-void WASDController::controlPlayer(const sf::Event& event, Character& player) {
-    if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
-        switch (keyPressed->code) {
-            case sf::Keyboard::Key::D:
-                player.setMovingRight(true);
-                break;
-            case sf::Keyboard::Key::A:
-                player.setMovingLeft(true);
-                break;
-            case sf::Keyboard::Key::W:
-                player.setJumping(true);
-                break;
-            default:
-                break;
+std::string keyName(Key key) {
+    int index = static_cast<int>(key);
+    if (index >= static_cast<int>(Key::A) && index <= static_cast<int>(Key::Z)) {
+        return std::string(1, static_cast<char>('A' + index - static_cast<int>(Key::A)));
+    }
+    for (const KeyName& entry : KEY_NAMES) {
+        if (entry.key == key) return entry.name;
+    }
+    for (const KeyRange& range : KEY_RANGES) {
+        int offset = index - static_cast<int>(range.first);
+        if (offset >= 0 && offset < range.count) return range.prefix + std::to_string(range.firstNumber + offset);
+    }
+    return "Unknown";
+}
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) text.remove_prefix(1);
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) text.remove_suffix(1);
+    return text;
+}
+
+bool sameInput(const Controller::Binding& a, const Controller::Binding& b) {
+    if (a.type != b.type) return false;
+    switch (a.type) {
+        case Controller::Binding::Type::Key:       return a.key == b.key;
+        case Controller::Binding::Type::PadButton: return a.pad == b.pad && a.button == b.button;
+        case Controller::Binding::Type::PadAxis:   return a.pad == b.pad && a.axis == b.axis && a.positive == b.positive;
+    }
+    return false;
+}
+
+}
+
+Controller::Controller()
+    : m_padButtons{},
+      m_padAxes{},
+      m_tapped(0)
+{
+    auto key = [](Key code) {
+        Binding binding;
+        binding.key = code;
+        return std::vector<Binding>{binding};
+    };
+    setBindings(Action::HotRight, key(Key::Right));
+    setBindings(Action::HotLeft, key(Key::Left));
+    setBindings(Action::HotJump, key(Key::Up));
+    setBindings(Action::ColdRight, key(Key::D));
+    setBindings(Action::ColdLeft, key(Key::A));
+    setBindings(Action::ColdJump, key(Key::W));
+}
+
+bool Controller::loadBindings(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        LOG_WARNING(LogCategory::Input, "no controls file " << path << ", using the default keys");
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        std::string_view text(line);
+        text = trim(text.substr(0, text.find('#')));
+        if (text.empty()) continue;
+
+        std::size_t equals = text.find('=');
+        std::string_view name = trim(text.substr(0, equals));
+        auto action = std::find_if(std::begin(ACTION_NAMES), std::end(ACTION_NAMES),
+                                   [name](const char* candidate) { return equalsIgnoringCase(name, candidate); });
+        if (equals == std::string_view::npos || action == std::end(ACTION_NAMES)) {
+            LOG_WARNING(LogCategory::Input, path << ":" << lineNumber << ": expected <action> = <bindings>, e.g. hot_jump = Up");
+            continue;
+        }
+
+        std::vector<Binding> bindings;
+        std::string_view list = text.substr(equals + 1);
+        while (true) {
+            std::size_t comma = list.find(',');
+            std::string_view item = trim(list.substr(0, comma));
+            Binding binding;
+            if (parseBinding(item, binding) && isReserved(binding)) {
+                LOG_WARNING(LogCategory::Input, path << ":" << lineNumber << ": '" << item << "' is a game command and can't be bound");
+            } else if (parseBinding(item, binding)) {
+                bindings.push_back(binding);
+            } else if (!item.empty()) {
+                LOG_WARNING(LogCategory::Input, path << ":" << lineNumber << ": unknown key or pad input '" << item << "'");
+            }
+            if (comma == std::string_view::npos) break;
+            list.remove_prefix(comma + 1);
         }
+        setBindings(static_cast<Action>(action - std::begin(ACTION_NAMES)), std::move(bindings));
     }
-    else if (const auto* keyReleased = event.getIf<sf::Event::KeyReleased>()) {
-        switch (keyReleased->code) {
-            case sf::Keyboard::Key::D:
-                player.setMovingRight(false);
-                break;
-            case sf::Keyboard::Key::A:
-                player.setMovingLeft(false);
-                break;
-            case sf::Keyboard::Key::W:
-                player.setJumping(false);
-                break;
-            default:
+
+    return true;
+}
+
+void Controller::setBindings(Action action, std::vector<Binding> bindings) {
+    m_bindings[static_cast<std::size_t>(action)] = std::move(bindings);
+}
+
+const std::vector<Controller::Binding>& Controller::getBindings(Action action) const {
+    return m_bindings[static_cast<std::size_t>(action)];
+}
+
+void Controller::handleEvent(const sf::Event& event) {
+    Binding input;
+    if (const auto* pressed = event.getIf<sf::Event::KeyPressed>()) {
+        if (pressed->code == Key::Unknown) return;
+        // Only a real press taps; OS key repeat resends it while held
+        const bool repeat = m_keys.test(static_cast<std::size_t>(pressed->code));
+        m_keys.set(static_cast<std::size_t>(pressed->code));
+        input.key = pressed->code;
+        if (!repeat) tap(input);
+    } else if (const auto* released = event.getIf<sf::Event::KeyReleased>()) {
+        if (released->code == Key::Unknown) return;
+        m_keys.reset(static_cast<std::size_t>(released->code));
+    } else if (const auto* buttonPressed = event.getIf<sf::Event::JoystickButtonPressed>()) {
+        if (buttonPressed->joystickId >= sf::Joystick::Count || buttonPressed->button >= 32) return;
+        const std::uint32_t bit = 1u << buttonPressed->button;
+        const bool repeat = (m_padButtons[buttonPressed->joystickId] & bit) != 0;
+        m_padButtons[buttonPressed->joystickId] |= bit;
+        input.type = Binding::Type::PadButton;
+        input.pad = buttonPressed->joystickId;
+        input.button = buttonPressed->button;
+        if (!repeat) tap(input);
+    } else if (const auto* buttonReleased = event.getIf<sf::Event::JoystickButtonReleased>()) {
+        if (buttonReleased->joystickId >= sf::Joystick::Count || buttonReleased->button >= 32) return;
+        m_padButtons[buttonReleased->joystickId] &= ~(1u << buttonReleased->button);
+    } else if (const auto* moved = event.getIf<sf::Event::JoystickMoved>()) {
+        if (moved->joystickId >= sf::Joystick::Count) return;
+        float& position = m_padAxes[moved->joystickId][static_cast<std::size_t>(moved->axis)];
+        const bool wasPushed = std::abs(position) >= AXIS_THRESHOLD;
+        position = moved->position;
+        if (!wasPushed && std::abs(position) >= AXIS_THRESHOLD) {
+            input.type = Binding::Type::PadAxis;
+            input.pad = moved->joystickId;
+            input.axis = moved->axis;
+            input.positive = position > 0.0f;
+            tap(input);
+        }
+    } else if (const auto* disconnected = event.getIf<sf::Event::JoystickDisconnected>()) {
+        if (disconnected->joystickId >= sf::Joystick::Count) return;
+        m_padButtons[disconnected->joystickId] = 0;
+        m_padAxes[disconnected->joystickId] = {};
+    } else if (event.is<sf::Event::FocusLost>()) {
+        // Releases while unfocused never arrive
+        releaseAll();
+    }
+}
+
+void Controller::releaseAll() {
+    m_keys.reset();
+    m_padButtons = {};
+    m_padAxes = {};
+    m_tapped = 0;
+}
+
+std::uint8_t Controller::sample(std::uint8_t pendingJumps) {
+    std::uint8_t inputs = m_tapped;
+    for (std::size_t i = 0; i < ACTION_COUNT; ++i) {
+        // Holding jump doesn't jump again; it only keeps a press the
+        // simulation hasn't used yet from being dropped
+        const bool jump = (ACTION_BITS[i] & JUMP_BITS) != 0;
+        if (jump && !(pendingJumps & ACTION_BITS[i])) continue;
+
+        for (const Binding& binding : m_bindings[i]) {
+            if (isHeld(binding)) {
+                inputs |= ACTION_BITS[i];
                 break;
+            }
         }
     }
+    m_tapped = 0;
+    return inputs;
+}
+
+bool Controller::isHeld(const Binding& binding) const {
+    switch (binding.type) {
+        case Binding::Type::Key:
+            return binding.key != Key::Unknown && m_keys.test(static_cast<std::size_t>(binding.key));
+        case Binding::Type::PadButton:
+            return (m_padButtons[binding.pad] >> binding.button) & 1u;
+        case Binding::Type::PadAxis: {
+            float position = m_padAxes[binding.pad][static_cast<std::size_t>(binding.axis)];
+            return binding.positive ? position >= AXIS_THRESHOLD : position <= -AXIS_THRESHOLD;
+        }
+    }
+    return false;
+}
+
+void Controller::tap(const Binding& pressed) {
+    for (std::size_t i = 0; i < ACTION_COUNT; ++i) {
+        for (const Binding& binding : m_bindings[i]) {
+            if (sameInput(binding, pressed)) m_tapped |= ACTION_BITS[i];
+        }
+    }
+}
+
+bool Controller::parseBinding(std::string_view text, Binding& binding) {
+    binding = Binding();
+    if (!startsWithIgnoringCase(text, "Pad")) {
+        binding.type = Binding::Type::Key;
+        return parseKey(text, binding.key);
+    }
+
+    // Pad<N>.Button<M> or Pad<N>.<axis>+/-
+    std::size_t dot = text.find('.');
+    if (dot == std::string_view::npos || !parseNumber(text.substr(3, dot - 3), sf::Joystick::Count, binding.pad)) {
+        return false;
+    }
+    std::string_view input = text.substr(dot + 1);
+
+    if (startsWithIgnoringCase(input, "Button")) {
+        binding.type = Binding::Type::PadButton;
+        return parseNumber(input.substr(6), 32, binding.button);
+    }
+
+    if (input.size() < 2 || (input.back() != '+' && input.back() != '-')) return false;
+    binding.type = Binding::Type::PadAxis;
+    binding.positive = input.back() == '+';
+    input.remove_suffix(1);
+    for (std::size_t i = 0; i < sf::Joystick::AxisCount; ++i) {
+        if (equalsIgnoringCase(input, AXIS_NAMES[i])) {
+            binding.axis = static_cast<Axis>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string Controller::describe(const Binding& binding) {
+    switch (binding.type) {
+        case Binding::Type::Key:
+            return keyName(binding.key);
+        case Binding::Type::PadButton:
+            return "Pad" + std::to_string(binding.pad) + ".Button" + std::to_string(binding.button);
+        case Binding::Type::PadAxis:
+            return "Pad" + std::to_string(binding.pad) + "." + AXIS_NAMES[static_cast<std::size_t>(binding.axis)] +
+                   (binding.positive ? "+" : "-");
+    }
+    return "?";
+}
+
+const char* Controller::actionName(Action action) {
+    return ACTION_NAMES[static_cast<std::size_t>(action)];
 }
@@ -1,27 +1,59 @@
 #include "include/Doors.h"
-#include <iostream>
+#include "include/ResourceCache.h"
+#include "include/Log.h"
 
-Doors::Doors(const sf::Vector2f& doorLocation)
+Doors::Doors(DoorKind kind, const sf::Vector2f& doorLocation)
     : m_isOpen(false),
       m_heightRaised(0.0f),
       m_playerAtDoor(false),
-      m_doorLocation(doorLocation)
+      m_doorLocation(doorLocation),
+      m_previousDoorLocation(doorLocation),
+      m_kind(kind)
 {
-    loadCommonImages();
+    m_rect = sf::FloatRect(m_doorLocation, sf::Vector2f(CHUNK_SIZE, 2 * CHUNK_SIZE));
+
+    LOG_DEBUG(LogCategory::Door, (m_kind == DoorKind::Fire ? "FireDoor" : "WaterDoor") << " created at position: "
+              << doorLocation.x << ", " << doorLocation.y);
+}
+
+namespace {
+const char* const FRAME_IMAGE = "data/door_images/door_frame.png";
+const char* const BACKGROUND_IMAGE = "data/door_images/door_background.png";
+const char* const FIRE_DOOR_IMAGE = "data/door_images/fire_door.png";
+const char* const WATER_DOOR_IMAGE = "data/door_images/water_door.png";
 }
 
-void Doors::loadCommonImages() {
-    if (!m_frameTexture.loadFromFile("data/door_images/door_frame.png")) {}
-    if (!m_backgroundTexture.loadFromFile("data/door_images/door_background.png")) {}
+void Doors::loadImages() {
+    m_frameTexture = TextureCache::instance().get(FRAME_IMAGE);
+    m_backgroundTexture = TextureCache::instance().get(BACKGROUND_IMAGE);
 
-    m_frameSprite.emplace(m_frameTexture);
-    m_backgroundSprite.emplace(m_backgroundTexture);
+    m_frameSprite.emplace(*m_frameTexture);
+    m_backgroundSprite.emplace(*m_backgroundTexture);
 
     m_backgroundSprite->setPosition(m_doorLocation);
     m_frameSprite->setPosition(sf::Vector2f(
         m_doorLocation.x - CHUNK_SIZE,
         m_doorLocation.y - 2 * CHUNK_SIZE
     ));
+
+    m_doorTexture = TextureCache::instance().get(m_kind == DoorKind::Fire ? FIRE_DOOR_IMAGE : WATER_DOOR_IMAGE);
+    m_doorSprite.emplace(*m_doorTexture);
+    m_doorSprite->setPosition(m_doorLocation);
+}
+
+std::vector<std::string> Doors::getImagePaths() {
+    return {FRAME_IMAGE, BACKGROUND_IMAGE, FIRE_DOOR_IMAGE, WATER_DOOR_IMAGE};
+}
+
+void Doors::setPlayerAtDoor(bool atDoor) {
+    if (atDoor && !m_playerAtDoor) {
+        if (m_kind == DoorKind::Fire) {
+            LOG_INFO(LogCategory::Door, "[FIRE DOOR] Hot player approaching door...");
+        } else {
+            LOG_INFO(LogCategory::Door, "[WATER DOOR] Cold player approaching door...");
+        }
+    }
+    m_playerAtDoor = atDoor;
 }
 
 void Doors::tryRaiseDoor() {
@@ -30,9 +62,8 @@ void Doors::tryRaiseDoor() {
         m_heightRaised += DOOR_SPEED;
         if (m_heightRaised >= 31.0f && !m_isOpen) {
             m_isOpen = true;
-            std::cout << "[DOOR] Door fully OPEN!" << std::endl;
+            LOG_INFO(LogCategory::Door, "[DOOR] Door fully OPEN!");
         }
-        if (m_doorSprite) m_doorSprite->setPosition(m_doorLocation);
     }
     // FIXED Issue (Kumail's): Don't auto-close doors - they stay open once opened for win condition
     // else if (!m_playerAtDoor && m_heightRaised > 0.0f) {
@@ -46,77 +77,44 @@ void Doors::tryRaiseDoor() {
     // }
 }
 
-void Doors::draw(sf::RenderWindow& window) {
-    if (m_backgroundSprite) window.draw(*m_backgroundSprite);
-    if (m_doorSprite) window.draw(*m_doorSprite);
-    if (m_frameSprite) window.draw(*m_frameSprite);
+void Doors::storePreviousPosition() {
+    m_previousDoorLocation = m_doorLocation;
 }
 
-bool Doors::isOpen() const { return m_isOpen; }
-sf::FloatRect Doors::getRect() const { return m_rect; }
-
-FireDoor::FireDoor(const sf::Vector2f& doorLocation) : Doors(doorLocation) {
-    if (!m_doorTexture.loadFromFile("data/door_images/fire_door.png")) {}
-    m_doorSprite.emplace(m_doorTexture);
-    m_doorSprite->setPosition(m_doorLocation);
-    m_rect = sf::FloatRect(m_doorLocation, sf::Vector2f(static_cast<float>(m_doorTexture.getSize().x), static_cast<float>(m_doorTexture.getSize().y)));
+Doors::State Doors::saveState() const {
+    return State{m_doorLocation, m_previousDoorLocation, m_heightRaised, m_isOpen, m_playerAtDoor};
+}
 
-    std::cout << "FireDoor created at position: " << doorLocation.x << ", " << doorLocation.y << std::endl;
+void Doors::restoreState(const State& state) {
+    m_doorLocation = state.doorLocation;
+    m_previousDoorLocation = state.previousDoorLocation;
+    m_heightRaised = state.heightRaised;
+    m_isOpen = state.isOpen;
+    m_playerAtDoor = state.playerAtDoor;
 }
 
-void FireDoor::tryOpen(Character& player) {
-    sf::FloatRect detectionZone = m_rect;
-    detectionZone.position.x -= 10.0f;
-    detectionZone.position.y -= 10.0f;
-    detectionZone.size.x += 20.0f;
-    detectionZone.size.y += 20.0f;
-
-    bool wasAtDoor = m_playerAtDoor;
-
-    if (player.getRect().findIntersection(detectionZone)) {
-        if (player.getType() == "hot") {
-            m_playerAtDoor = true;
-            if (!wasAtDoor) {
-                std::cout << "[FIRE DOOR] Hot player approaching door..." << std::endl;
-            }
-        } else {
-            m_playerAtDoor = false;
-        }
-    } else {
-        m_playerAtDoor = false;
+void Doors::draw(sf::RenderTarget& target, float alpha) {
+    if (m_backgroundSprite) target.draw(*m_backgroundSprite);
+    if (m_doorSprite) {
+        m_doorSprite->setPosition(m_previousDoorLocation + (m_doorLocation - m_previousDoorLocation) * alpha);
+        target.draw(*m_doorSprite);
     }
-    tryRaiseDoor();
+    if (m_frameSprite) target.draw(*m_frameSprite);
 }
 
-WaterDoor::WaterDoor(const sf::Vector2f& doorLocation) : Doors(doorLocation) {
-    if (!m_doorTexture.loadFromFile("data/door_images/water_door.png")) {}
-    m_doorSprite.emplace(m_doorTexture);
-    m_doorSprite->setPosition(m_doorLocation);
-    m_rect = sf::FloatRect(m_doorLocation, sf::Vector2f(static_cast<float>(m_doorTexture.getSize().x), static_cast<float>(m_doorTexture.getSize().y)));
+bool Doors::isOpen() const { return m_isOpen; }
+sf::FloatRect Doors::getRect() const { return m_rect; }
 
-    std::cout << "WaterDoor created at position: " << doorLocation.x << ", " << doorLocation.y << std::endl;
+sf::FloatRect Doors::getTriggerZone() const {
+    sf::FloatRect zone = m_rect;
+    zone.position.x -= 10.0f;
+    zone.position.y -= 10.0f;
+    zone.size.x += 20.0f;
+    zone.size.y += 20.0f;
+    return zone;
 }
+DoorKind Doors::getKind() const { return m_kind; }
 
-void WaterDoor::tryOpen(Character& player) {
-    sf::FloatRect detectionZone = m_rect;
-    detectionZone.position.x -= 10.0f;
-    detectionZone.position.y -= 10.0f;
-    detectionZone.size.x += 20.0f;
-    detectionZone.size.y += 20.0f;
-
-    bool wasAtDoor = m_playerAtDoor;
-
-    if (player.getRect().findIntersection(detectionZone)) {
-        if (player.getType() == "cold") {
-            m_playerAtDoor = true;
-            if (!wasAtDoor) {
-                std::cout << "[WATER DOOR] Cold player approaching door..." << std::endl;
-            }
-        } else {
-            m_playerAtDoor = false;
-        }
-    } else {
-        m_playerAtDoor = false;
-    }
-    tryRaiseDoor();
+CharacterKind Doors::getOpener() const {
+    return m_kind == DoorKind::Fire ? CharacterKind::Hot : CharacterKind::Cold;
 }
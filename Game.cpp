@@ -1,439 +1,289 @@
 #include "include/Game.h"
 #include "include/Controller.h"
-#include <iostream>
-
-Game::Game(int levelNumber)
-    : m_window(sf::VideoMode({640, 480}), "Hot and Cold - Level " + std::to_string(levelNumber)),
-      m_board(nullptr),
-      m_hotPlayer(nullptr),
-      m_coldPlayer(nullptr),
-      m_gameState(GameState::Playing),
-      m_currentLevel(levelNumber)
+#include "include/ResourceCache.h"
+#include "include/Log.h"
+#include "include/ResultsScene.h"
+#include <filesystem>
+
+Game::Game(SceneStack& stack, SceneContext& context, int levelNumber)
+    : m_drawnFirstFrame(false),
+      m_stack(stack),
+      m_context(context),
+      m_camera(sf::Vector2f(640.0f, 480.0f)),
+#if HOT_AND_COLD_PROFILING
+      m_profilerHud(context.font),
+#endif
+      m_alpha(1.0f),
+      m_attempt(0)
 {
-    m_window.setFramerateLimit(60);
-
-    if (!m_font.openFromFile("C:/Windows/Fonts/arial.ttf")) {
-        std::cerr << "Warning: Could not load font" << std::endl;
-    }
-
-    m_arrowsController = std::make_unique<ArrowsController>();
-    m_wasdController = std::make_unique<WASDController>();
-
     initializeLevel(levelNumber);
 }
 
 Game::~Game() {
-    cleanup();
-    if (m_board) delete m_board;
+    if (m_replay.getTickCount() > 0) saveReplay();
 }
 
-void Game::initializeLevel(int levelNumber) {
-    cleanup();
-
-    // Load the appropriate level file
-    std::string levelFile = "data/level" + std::to_string(levelNumber) + ".txt";
-    std::cout << "[LEVEL LOAD] Loading: " << levelFile << std::endl;
-
-    if (m_board) delete m_board;
-    m_board = new Board(levelFile);
-
-    // Players start at bottom left and bottom right
-    m_hotPlayer = new Hot(sf::Vector2f(48.0f, 400.0f));
-    m_coldPlayer = new Cold(sf::Vector2f(560.0f, 400.0f));
-
-    m_players.push_back(m_hotPlayer);
-    m_players.push_back(m_coldPlayer);
-
-    // Doors at the top - using row 3 (y = 48) for proper positioning
-    // Doors at specific tile positions
-    m_doors.push_back(new FireDoor(sf::Vector2f(2.0f * 16, 2.0f * 16)));     // Row 2, Col 2
-    m_doors.push_back(new WaterDoor(sf::Vector2f(35.0f * 16, 2.0f * 16)));   // Row 2, Col 35
-
-    // Gate with proper button placement
-    // Left button, gate in middle, right button
-    // Left gate system
-    std::vector<sf::Vector2f> leftGateButtons = {
-        sf::Vector2f(6.0f * 16, 17.0f * 16),    // Button before gate
-        sf::Vector2f(14.0f * 16, 17.0f * 16)    // Button after gate
-    };
-    m_gates.push_back(new Gates(sf::Vector2f(10.0f * 16, 15.0f * 16), leftGateButtons));
-
-    // Right gate system
-    std::vector<sf::Vector2f> rightGateButtons = {
-        sf::Vector2f(25.0f * 16, 17.0f * 16),
-        sf::Vector2f(33.0f * 16, 23.0f * 16)
-    };
-    m_gates.push_back(new Gates(sf::Vector2f(29.0f * 16, 15.0f * 16), rightGateButtons));
-
-    std::cout << "\n╔════════════════════════════════════════╗" << std::endl;
-    std::cout << "║   HOT AND COLD - Level " << levelNumber << " Loaded      ║" << std::endl;
-    std::cout << "╚════════════════════════════════════════╝" << std::endl;
-    std::cout << "\nOBJECTIVE:" << std::endl;
-    std::cout << "  - Hot (RED) must reach the FIRE DOOR (top-left)" << std::endl;
-    std::cout << "  - Cold (BLUE) must reach the WATER DOOR (top-right)" << std::endl;
-    std::cout << "  - BOTH players must reach their doors to WIN!" << std::endl;
-    std::cout << "\nCONTROLS:" << std::endl;
-    std::cout << "  Hot Player:  ← → ↑ (Arrow Keys)" << std::endl;
-    std::cout << "  Cold Player: A D W (WASD)" << std::endl;
-    std::cout << "  ESC: Quit | R: Restart | M: Menu" << std::endl;
-    std::cout << "\nMECHANICS:" << std::endl;
-    std::cout << "  - Hot dies in WATER (blue)" << std::endl;
-    std::cout << "  - Cold dies in LAVA (red/orange)" << std::endl;
-    std::cout << "  - Both die in GOO (green)" << std::endl;
-    std::cout << "  - Press PLATES to open GATES!" << std::endl;
-    std::cout << "\n════════════════════════════════════════\n" << std::endl;
+void Game::onActivate() {
+    // Keys let go while another scene was on top never reached us
+    m_context.controller.releaseAll();
+    m_context.window.setTitle("Hot and Cold - Level " + std::to_string(m_simulation.getCurrentLevel()));
 }
 
-void Game::run() {
-    while (m_window.isOpen()) {
-        handleEvents();
-        update();
-        draw();
+void Game::initializeLevel(int levelNumber) {
+    // A restart mid-attempt still keeps what was played so far
+    if (m_replay.getTickCount() > 0) saveReplay();
+
+    // The preloader has usually parsed the map while the menu was up
+    std::unique_ptr<Board> board = m_context.preloader.take(levelNumber);
+    m_simulation.initializeLevel(levelNumber, std::move(board));
+    loadImages();
+
+    beginAttempt();
+
+    LOG_INFO(LogCategory::Level, "\n╔════════════════════════════════════════╗");
+    LOG_INFO(LogCategory::Level, "║   HOT AND COLD - Level " << levelNumber << " Loaded      ║");
+    LOG_INFO(LogCategory::Level, "╚════════════════════════════════════════╝");
+    LOG_INFO(LogCategory::Level, "\nOBJECTIVE:");
+    LOG_INFO(LogCategory::Level, "  - Hot (RED) must reach the FIRE DOOR (top-left)");
+    LOG_INFO(LogCategory::Level, "  - Cold (BLUE) must reach the WATER DOOR (top-right)");
+    LOG_INFO(LogCategory::Level, "  - BOTH players must reach their doors to WIN!");
+    LOG_INFO(LogCategory::Level, "\nCONTROLS:");
+    for (std::size_t i = 0; i < Controller::ACTION_COUNT; ++i) {
+        auto action = static_cast<Controller::Action>(i);
+        std::string keys;
+        for (const Controller::Binding& binding : m_context.controller.getBindings(action)) {
+            keys += (keys.empty() ? "" : ", ") + Controller::describe(binding);
+        }
+        LOG_INFO(LogCategory::Level, "  " << Controller::actionName(action) << ": " << (keys.empty() ? "(unbound)" : keys));
     }
+    LOG_INFO(LogCategory::Level, "  ESC: Menu | R: Restart (when won/lost)");
+    LOG_INFO(LogCategory::Level, "\nMECHANICS:");
+    LOG_INFO(LogCategory::Level, "  - Hot dies in WATER (blue)");
+    LOG_INFO(LogCategory::Level, "  - Cold dies in LAVA (red/orange)");
+    LOG_INFO(LogCategory::Level, "  - Both die in GOO (green)");
+    LOG_INFO(LogCategory::Level, "  - Press PLATES to open GATES!");
+    LOG_INFO(LogCategory::Level, "\n════════════════════════════════════════\n");
 }
 
-void Game::handleEvents() {
-    while (const auto event = m_window.pollEvent()) {
-        if (event->is<sf::Event::Closed>()) {
-            m_window.close();
-        }
+// R: the board, textures and tile layer are already in place, so only the
+// entity state goes back to its loaded values
+void Game::restartLevel() {
+    if (m_replay.getTickCount() > 0) saveReplay();
 
-        if (const auto* keyPressed = event->getIf<sf::Event::KeyPressed>()) {
-            if (keyPressed->code == sf::Keyboard::Key::Escape) {
-                m_window.close();
-            }
-
-            if (keyPressed->code == sf::Keyboard::Key::R) {
-                if (m_gameState == GameState::Won || m_gameState == GameState::Lost) {
-                    std::cout << "\n=== RESTARTING LEVEL ===" << std::endl;
-                    m_gameState = GameState::Playing;
-                    initializeLevel(m_currentLevel);
-                }
-            }
-
-            if (keyPressed->code == sf::Keyboard::Key::M) {
-                if (m_gameState == GameState::Won || m_gameState == GameState::Lost) {
-                    std::cout << "\n=== RETURNING TO MAIN MENU ===" << std::endl;
-                    m_window.close();
-                }
-            }
-        }
+    sf::Clock restartClock;
+    m_simulation.restart();
+    LOG_INFO(LogCategory::Level, "[RESTART] Level state restored in "
+              << restartClock.getElapsedTime().asMicroseconds() << " us");
 
-        if (m_gameState == GameState::Playing) {
-            if (m_hotPlayer && !m_hotPlayer->isDead()) {
-                m_arrowsController->controlPlayer(*event, *m_hotPlayer);
-            }
-            if (m_coldPlayer && !m_coldPlayer->isDead()) {
-                m_wasdController->controlPlayer(*event, *m_coldPlayer);
-            }
-        }
-    }
+    beginAttempt();
 }
 
-void Game::update() {
-    if (m_gameState != GameState::Playing) return;
+void Game::beginAttempt() {
+    ++m_attempt;
+    m_replay.begin(m_simulation.getCurrentLevel());
 
-    for (auto* player : m_players) {
-        if (player && !player->isDead()) {
-            player->update(*m_board);  // Dereference pointer to Board
-        }
-    }
+    // Loading time is not simulation time
+    m_accumulator = sf::Time::Zero;
+}
 
-    checkCollisions();
-    checkDeath();
+// The simulation never touches the GPU; textures are attached here so the
+// headless runner can share the same entity classes.
+void Game::loadImages() {
+    m_simulation.getBoard().loadImages();
+    m_tileLayer.build(m_simulation.getBoard());
 
-    for (auto* door : m_doors) {
-        for (auto* player : m_players) {
-            if (player && !player->isDead()) {
-                door->tryOpen(*player);
-            }
-        }
+    for (auto& player : m_simulation.getPlayers()) {
+        player.loadImages();
     }
 
-    for (auto* gate : m_gates) {
-        gate->tryOpen(m_players);
+    for (auto& door : m_simulation.getDoors()) {
+        door.loadImages();
     }
 
-    if (checkWin()) {
-        m_gameState = GameState::Won;
-        std::cout << "\n╔════════════════════════════════════════╗" << std::endl;
-        std::cout << "║              LEVEL COMPLETE!           ║" << std::endl;
-        std::cout << "╚════════════════════════════════════════╝" << std::endl;
-        std::cout << "  Both players reached their doors!" << std::endl;
-        std::cout << "  Press R to restart" << std::endl;
-        std::cout << "  Press M for main menu" << std::endl;
-        std::cout << "  Press ESC to quit\n" << std::endl;
+    for (auto& gate : m_simulation.getGates()) {
+        gate.loadImages();
     }
 
-    bool hotDead = (m_hotPlayer == nullptr || m_hotPlayer->isDead());
-    bool coldDead = (m_coldPlayer == nullptr || m_coldPlayer->isDead());
-
-    if (hotDead && coldDead && m_gameState == GameState::Playing) {
-        m_gameState = GameState::Lost;
-        std::cout << "\n╔════════════════════════════════════════╗" << std::endl;
-        std::cout << "║             GAME OVER                   ║" << std::endl;
-        std::cout << "╚════════════════════════════════════════╝" << std::endl;
-        std::cout << "  Both players died!" << std::endl;
-        std::cout << "  Press R to try again" << std::endl;
-        std::cout << "  Press M for main menu" << std::endl;
-        std::cout << "  Press ESC to quit\n" << std::endl;
-    }
+    LOG_DEBUG(LogCategory::Resource, "[RESOURCES] " << TextureCache::instance().getSize() << " textures cached, "
+              << TextureCache::instance().getHits() << " hits, "
+              << TextureCache::instance().getMisses() << " misses");
 }
 
-void Game::draw() {
-    m_window.clear(sf::Color::Black);
+void Game::update(sf::Time elapsed) {
+    const sf::Time tick = sf::seconds(1.0f / Simulation::TICKS_PER_SECOND);
 
-    drawBoard();
+    m_accumulator += elapsed;
 
-    for (auto* gate : m_gates) {
-        gate->draw(m_window);
+    int ticks = 0;
+    while (m_accumulator >= tick && ticks < MAX_CATCH_UP_TICKS) {
+        this->tick();
+        m_accumulator -= tick;
+        ++ticks;
     }
 
-    for (auto* door : m_doors) {
-        door->draw(m_window);
+    // After a long hitch, drop the backlog instead of fast-forwarding
+    if (m_accumulator >= tick) {
+        m_accumulator = sf::Time::Zero;
     }
 
-    for (auto* player : m_players) {
-        if (player) {
-            player->draw(m_window);
+    m_alpha = m_accumulator / tick;
+}
+
+void Game::handleEvent(const sf::Event& event) {
+    if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
+        // Back to the menu, as closing the game window always did; Esc
+        // there quits
+        if (keyPressed->code == sf::Keyboard::Key::Escape) {
+            m_stack.pop();
+            return;
         }
-    }
 
-    drawGameStateText();
+#if HOT_AND_COLD_PROFILING
+        if (keyPressed->code == sf::Keyboard::Key::F3) {
+            m_profilerHud.toggle();
+        }
+#endif
+    }
 
-    m_window.display();
+    // Only noted here; the simulation sees it when the next tick samples
+    m_context.controller.handleEvent(event);
 }
 
-void Game::drawBoard() {
-    const auto& textures = m_board->getTextures();  // Use -> for pointer
-    const auto& gameMap = m_board->getGameMap();    // Use -> for pointer
+void Game::tick() {
+    PROFILE_PHASE(Phase::Update);
 
-    auto bgIt = textures.find("background");
-    if (bgIt != textures.end()) {
-        sf::Sprite bgSprite(bgIt->second);
-        sf::Vector2u windowSize = m_window.getSize();
-        sf::FloatRect spriteSize = bgSprite.getLocalBounds();
+    if (m_simulation.getGameState() != GameState::Playing) return;
 
-        bgSprite.setScale(sf::Vector2f(
-            static_cast<float>(windowSize.x) / spriteSize.size.x,
-            static_cast<float>(windowSize.y) / spriteSize.size.y
-        ));
-        m_window.draw(bgSprite);
-    } else {
-        sf::RectangleShape bg(sf::Vector2f(640, 480));
-        bg.setFillColor(sf::Color(100, 100, 100));
-        m_window.draw(bg);
+    // One snapshot per tick, recorded exactly as the simulation gets it
+    std::uint8_t inputs = m_context.controller.sample(Replay::pendingJumps(m_simulation));
+    if (!m_context.recordDirectory.empty()) {
+        m_replay.recordTick(inputs);
     }
+    Replay::applyInputs(m_simulation, inputs);
 
-    const int CHUNK_SIZE = 16;
-    for (size_t y = 0; y < gameMap.size(); ++y) {
-        for (size_t x = 0; x < gameMap[y].size(); ++x) {
-            const std::string& tile = gameMap[y][x];
-
-            if (tile != "0") {
-                auto it = textures.find(tile);
-                if (it != textures.end()) {
-                    sf::Sprite tileSprite(it->second);
-                    tileSprite.setPosition(sf::Vector2f(
-                        static_cast<float>(x * CHUNK_SIZE),
-                        static_cast<float>(y * CHUNK_SIZE)
-                    ));
-                    m_window.draw(tileSprite);
-                } else {
-                    sf::RectangleShape fallback(sf::Vector2f(CHUNK_SIZE, CHUNK_SIZE));
-                    fallback.setPosition(sf::Vector2f(
-                        static_cast<float>(x * CHUNK_SIZE),
-                        static_cast<float>(y * CHUNK_SIZE)
-                    ));
-
-                    if (tile == "2") {
-                        fallback.setFillColor(sf::Color(255, 80, 0));
-                    } else if (tile == "3") {
-                        fallback.setFillColor(sf::Color(0, 120, 255));
-                    } else if (tile == "4") {
-                        fallback.setFillColor(sf::Color(50, 255, 50));
-                    } else {
-                        fallback.setFillColor(sf::Color(70, 70, 70));
-                    }
-
-                    m_window.draw(fallback);
-                }
-            }
-        }
-    }
-}
+    m_simulation.update();
 
-void Game::drawGameStateText() {
-    if (m_gameState == GameState::Won) {
-        sf::RectangleShape overlay(sf::Vector2f(500, 200));
-        overlay.setPosition(sf::Vector2f(70, 140));
-        overlay.setFillColor(sf::Color(0, 150, 0, 240));
-        overlay.setOutlineColor(sf::Color(255, 215, 0));
-        overlay.setOutlineThickness(5.0f);
-        m_window.draw(overlay);
-
-        sf::Text titleText(m_font, "LEVEL COMPLETE!", 36);
-        titleText.setFillColor(sf::Color::White);
-        titleText.setPosition(sf::Vector2f(150, 170));
-        m_window.draw(titleText);
-
-        sf::Text instructionsText(m_font, "R: Restart  M: Menu  ESC: Quit", 18);
-        instructionsText.setFillColor(sf::Color::White);
-        instructionsText.setPosition(sf::Vector2f(180, 240));
-        m_window.draw(instructionsText);
-
-    } else if (m_gameState == GameState::Lost) {
-        sf::RectangleShape overlay(sf::Vector2f(500, 200));
-        overlay.setPosition(sf::Vector2f(70, 140));
-        overlay.setFillColor(sf::Color(150, 0, 0, 240));
-        overlay.setOutlineColor(sf::Color::White);
-        overlay.setOutlineThickness(5.0f);
-        m_window.draw(overlay);
-
-        sf::Text titleText(m_font, "GAME OVER", 36);
-        titleText.setFillColor(sf::Color::White);
-        titleText.setPosition(sf::Vector2f(210, 170));
-        m_window.draw(titleText);
-
-        sf::Text instructionsText(m_font, "R: Restart  M: Menu  ESC: Quit", 18);
-        instructionsText.setFillColor(sf::Color::White);
-        instructionsText.setPosition(sf::Vector2f(180, 240));
-        m_window.draw(instructionsText);
+    if (m_simulation.getGameState() != GameState::Playing && m_replay.getTickCount() > 0) {
+        saveReplay();
     }
-}
 
-void Game::checkDeath() {
-    for (auto* player : m_players) {
-        if (!player || player->isDead()) continue;
-
-        sf::FloatRect playerRect = player->getRect();
-        std::string playerType = player->getType();
-
-        if (playerType == "cold") {
-            for (const auto& lava : m_board->getLavaPools()) {  // Use -> for pointer
-                if (playerRect.findIntersection(lava)) {
-                    player->kill();
-                    std::cout << "💀 COLD died in LAVA!" << std::endl;
-                    break;
-                }
-            }
+    if (m_simulation.getGameState() == GameState::Won) {
+        // Likely played next; get it ready while the win screen is up
+        int level = m_simulation.getCurrentLevel();
+        m_context.lastWonLevel = level;
+        if (std::filesystem::exists(Simulation::getLevelPath(level + 1))) {
+            m_context.preloader.request(level + 1);
         }
 
-        if (playerType == "hot") {
-            for (const auto& water : m_board->getWaterPools()) {  // Use -> for pointer
-                if (playerRect.findIntersection(water)) {
-                    player->kill();
-                    std::cout << "💀 HOT died in WATER!" << std::endl;
-                    break;
-                }
-            }
-        }
+        LOG_INFO(LogCategory::Level, "\n╔════════════════════════════════════════╗");
+        LOG_INFO(LogCategory::Level, "║              LEVEL COMPLETE!           ║");
+        LOG_INFO(LogCategory::Level, "╚════════════════════════════════════════╝");
+        LOG_INFO(LogCategory::Level, "  Both players reached their doors!");
+        LOG_INFO(LogCategory::Level, "  Press R to restart");
+        LOG_INFO(LogCategory::Level, "  Press M or ESC for main menu\n");
 
-        if (!player->isDead()) {
-            for (const auto& goo : m_board->getGooPools()) {  // Use -> for pointer (for Burair)
-                if (playerRect.findIntersection(goo)) {
-                    player->kill();
-                    std::cout << "DEAD_EMOJI " << playerType << " died in GOO!" << std::endl;
-                    break;
-                }
-            }
-        }
+        m_stack.push(std::make_unique<ResultsScene>(m_stack, m_context, *this, true));
     }
-}
 
-void Game::checkCollisions() {
-    for (auto* gate : m_gates) {
-        if (gate->isOpen()) continue;
-
-        sf::FloatRect gateRect = gate->getGateRect();
-
-        for (auto* player : m_players) {
-            if (!player || player->isDead()) continue;
-
-            sf::FloatRect playerRect = player->getRect();
-            auto intersection = playerRect.findIntersection(gateRect);
-
-            if (intersection) {
-                sf::FloatRect overlap = *intersection;
-
-                if (overlap.size.x < overlap.size.y) {
-                    if (playerRect.position.x < gateRect.position.x) {
-                        playerRect.position.x -= overlap.size.x;
-                    } else {
-                        playerRect.position.x += overlap.size.x;
-                    }
-                } else {
-                    if (playerRect.position.y < gateRect.position.y) {
-                        playerRect.position.y -= overlap.size.y;
-                    } else {
-                        playerRect.position.y += overlap.size.y;
-                    }
-                }
-
-                player->setRect(playerRect);
-            }
-        }
+    if (m_simulation.getGameState() == GameState::Lost) {
+        LOG_INFO(LogCategory::Level, "\n╔════════════════════════════════════════╗");
+        LOG_INFO(LogCategory::Level, "║             GAME OVER                   ║");
+        LOG_INFO(LogCategory::Level, "╚════════════════════════════════════════╝");
+        LOG_INFO(LogCategory::Level, "  Both players died!");
+        LOG_INFO(LogCategory::Level, "  Press R to try again");
+        LOG_INFO(LogCategory::Level, "  Press M or ESC for main menu\n");
+
+        m_stack.push(std::make_unique<ResultsScene>(m_stack, m_context, *this, false));
     }
 }
 
-bool Game::checkWin() {
-    static bool lastWinState = false;  // Track state changes
-
-    bool hotAtFireDoor = false;
-    bool coldAtWaterDoor = false;
+void Game::draw(sf::RenderTarget& target) {
+    PROFILE_PHASE(Phase::Draw);
 
-    if (!m_hotPlayer || m_hotPlayer->isDead()) return false;
-    if (!m_coldPlayer || m_coldPlayer->isDead()) return false;
+    updateCamera(m_alpha);
+    drawBoard(target);
 
-    for (auto* door : m_doors) {
-        if (!door->isOpen()) continue;
-
-        sf::FloatRect doorRect = door->getRect();
+    for (auto& gate : m_simulation.getGates()) {
+        gate.draw(target);
+    }
 
-        if (m_hotPlayer->getRect().findIntersection(doorRect)) {
-            if (dynamic_cast<FireDoor*>(door) != nullptr) {
-                hotAtFireDoor = true;
-            }
-        }
+    for (auto& door : m_simulation.getDoors()) {
+        door.draw(target, m_alpha);
+    }
 
-        if (m_coldPlayer->getRect().findIntersection(doorRect)) {
-            if (dynamic_cast<WaterDoor*>(door) != nullptr) {
-                coldAtWaterDoor = true;
-            }
-        }
+    for (auto& player : m_simulation.getPlayers()) {
+        player.draw(target, m_alpha);
     }
 
-    bool currentWinState = (hotAtFireDoor && coldAtWaterDoor);
+    // Overlays are in screen space
+    target.setView(target.getDefaultView());
 
-    // Only log when state changes
-    if (currentWinState && !lastWinState) {
-        std::cout << "[WIN] ★★★ WIN CONDITION MET! ★★★" << std::endl;
+#if HOT_AND_COLD_PROFILING
+    if (m_profilerHud.isVisible()) {
+        m_profilerHud.update();
+        target.draw(m_profilerHud);
     }
+#endif
 
-    lastWinState = currentWinState;
-    return currentWinState;
+    if (!m_drawnFirstFrame) {
+        LOG_INFO(LogCategory::Level, "[LEVEL LOAD] First frame " << m_startClock.getElapsedTime().asMilliseconds()
+                  << " ms after start");
+        m_drawnFirstFrame = true;
+    }
 }
 
-bool Game::shouldReturnToMenu() const {
-    return !m_window.isOpen();
+void Game::updateCamera(float alpha) {
+    std::vector<sf::FloatRect> targets;
+    for (const auto& player : m_simulation.getPlayers()) {
+        if (!player.isDead()) {
+            targets.emplace_back(player.getInterpolatedPosition(alpha), player.getRect().size);
+        }
+    }
+    m_camera.follow(targets, m_simulation.getBoard().getWorldSize());
 }
 
-void Game::cleanup() {
-    for (auto* player : m_players) {
-        delete player;
-    }
-    m_players.clear();
+void Game::drawBoard(sf::RenderTarget& target) {
+    PROFILE_PHASE(Phase::DrawBoard);
+
+    // The backdrop stays fixed to the screen while the level scrolls over it
+    target.setView(target.getDefaultView());
+
+    const sf::Texture* background = m_simulation.getBoard().getBackground();
+    sf::Vector2f windowSize(target.getSize());
 
-    for (auto* door : m_doors) {
-        delete door;
+    if (background && background->getSize().x > 0) {
+        sf::Sprite bgSprite(*background);
+        sf::FloatRect spriteSize = bgSprite.getLocalBounds();
+
+        bgSprite.setScale(sf::Vector2f(
+            windowSize.x / spriteSize.size.x,
+            windowSize.y / spriteSize.size.y
+        ));
+        target.draw(bgSprite);
+    } else {
+        sf::RectangleShape bg(windowSize);
+        bg.setFillColor(sf::Color(100, 100, 100));
+        target.draw(bg);
     }
-    m_doors.clear();
 
-    for (auto* gate : m_gates) {
-        delete gate;
+    // Tiles in view, one draw call
+    target.setView(m_camera.getView());
+    m_tileLayer.cull(m_camera.getVisibleArea());
+    target.draw(m_tileLayer);
+}
+
+void Game::saveReplay() {
+    m_replay.finish(m_simulation);
+
+    // Also runs from the destructor, so failures are reported, not thrown
+    std::error_code ignored;
+    std::filesystem::create_directories(m_context.recordDirectory, ignored);
+    std::string path = m_context.recordDirectory + "/level" + std::to_string(m_simulation.getCurrentLevel()) +
+                       "_attempt" + std::to_string(m_attempt) + ".hcr";
+    if (m_replay.saveToFile(path)) {
+        LOG_INFO(LogCategory::Replay, "[REPLAY] Saved " << m_replay.getTickCount() << " ticks to " << path);
     }
-    m_gates.clear();
 
-    m_hotPlayer = nullptr;
-    m_coldPlayer = nullptr;
+    m_replay.begin(m_simulation.getCurrentLevel());
 }
+
@@ -1,5 +1,6 @@
 #include "include/Gates.h"
-#include <iostream>
+#include "include/ResourceCache.h"
+#include "include/Log.h"
 
 Gates::Gates(const sf::Vector2f& gateLocation, const std::vector<sf::Vector2f>& plateLocations)
     : m_gateLocation(gateLocation),
@@ -7,72 +8,72 @@ Gates::Gates(const sf::Vector2f& gateLocation, const std::vector<sf::Vector2f>&
       m_isPressed(false),
       m_isOpen(false)
 {
-    loadImages();
+    // Sizes match gate.png / plate.png; they are fixed here so the rects do
+    // not depend on whether the textures were ever loaded
+    m_gateRect = sf::FloatRect(m_gateLocation, sf::Vector2f(CHUNK_SIZE, 3 * CHUNK_SIZE));
 
-    m_gateRect = sf::FloatRect(
-        m_gateLocation,
-        sf::Vector2f(32.0f, 96.0f) // Hardcoded approximate size if texture fails
-    );
-
-    // RELOAD LOGIC TO BE SAFE:
-    if (m_gateTexture.getSize().x > 0) {
-         m_gateRect.size = sf::Vector2f(static_cast<float>(m_gateTexture.getSize().x),
-                                        static_cast<float>(m_gateTexture.getSize().y));
+    for (const auto& location : m_plateLocations) {
+        m_plateRects.emplace_back(location, sf::Vector2f(CHUNK_SIZE, CHUNK_SIZE / 2));
     }
+}
 
-    for (const auto& location : m_plateLocations) {
-        sf::Vector2f size(32.0f, 16.0f);
-        if (m_plateTexture.getSize().x > 0) {
-            size = sf::Vector2f(static_cast<float>(m_plateTexture.getSize().x),
-                                static_cast<float>(m_plateTexture.getSize().y));
-        }
+namespace {
+const char* const GATE_IMAGE = "data/gates_and_plates/gate.png";
+const char* const PLATE_IMAGE = "data/gates_and_plates/plate.png";
+}
 
-        m_plateRects.emplace_back(location, size);
-        sf::Sprite plateSprite(m_plateTexture);
+void Gates::loadImages() {
+    m_gateTexture = TextureCache::instance().get(GATE_IMAGE);
+    m_plateTexture = TextureCache::instance().get(PLATE_IMAGE);
+
+    m_plateSprites.clear();
+    for (const auto& location : m_plateLocations) {
+        sf::Sprite plateSprite(*m_plateTexture);
         plateSprite.setPosition(location);
         m_plateSprites.push_back(plateSprite);
     }
-    m_gateSprite.emplace(m_gateTexture);
+    m_gateSprite.emplace(*m_gateTexture);
     m_gateSprite->setPosition(m_gateLocation);
 }
 
-void Gates::loadImages() {
-    if (!m_gateTexture.loadFromFile("data/gates_and_plates/gate.png")) {}
-    if (!m_plateTexture.loadFromFile("data/gates_and_plates/plate.png")) {}
+std::vector<std::string> Gates::getImagePaths() {
+    return {GATE_IMAGE, PLATE_IMAGE};
 }
 
-void Gates::tryOpen(const std::list<Character*>& players) {
-    bool platePressed = false;
-    for (const auto* player : players) {
-        if (!player || player->isDead()) continue;
-        for (const auto& plateRect : m_plateRects) {
-            if (checkCollision(player->getRect(), plateRect)) {
-                platePressed = true;
-                break;
-            }
-        }
-        if (platePressed) break;
-    }
-
-    m_isPressed = platePressed;
+void Gates::setPressed(bool pressed) {
+    m_isPressed = pressed;
 
     if (m_isPressed && !m_isOpen) {
         m_gateLocation.y -= 2 * CHUNK_SIZE;
         m_gateRect.position.y -= 2 * CHUNK_SIZE;
         if (m_gateSprite) m_gateSprite->setPosition(m_gateLocation);
         m_isOpen = true;
+        LOG_DEBUG(LogCategory::Gate, "Gate at " << m_gateLocation.x << " opened");
     }
     else if (!m_isPressed && m_isOpen) {
         m_gateLocation.y += 2 * CHUNK_SIZE;
         m_gateRect.position.y += 2 * CHUNK_SIZE;
         if (m_gateSprite) m_gateSprite->setPosition(m_gateLocation);
         m_isOpen = false;
+        LOG_DEBUG(LogCategory::Gate, "Gate at " << m_gateLocation.x << " closed");
     }
 }
 
-void Gates::draw(sf::RenderWindow& window) {
-    if (m_gateSprite) window.draw(*m_gateSprite);
-    for (const auto& plateSprite : m_plateSprites) window.draw(plateSprite);
+Gates::State Gates::saveState() const {
+    return State{m_gateLocation, m_gateRect, m_isPressed, m_isOpen};
+}
+
+void Gates::restoreState(const State& state) {
+    m_gateLocation = state.gateLocation;
+    m_gateRect = state.gateRect;
+    m_isPressed = state.isPressed;
+    m_isOpen = state.isOpen;
+    if (m_gateSprite) m_gateSprite->setPosition(m_gateLocation);
+}
+
+void Gates::draw(sf::RenderTarget& target) {
+    if (m_gateSprite) target.draw(*m_gateSprite);
+    for (const auto& plateSprite : m_plateSprites) target.draw(plateSprite);
 }
 
 //Gates Rectangle
@@ -88,8 +89,3 @@ const std::vector<sf::FloatRect>& Gates::getPlateRects() const {
 bool Gates::isOpen() const {
     return m_isOpen;
 }
-
-//Cllosion check for both
-bool Gates::checkCollision(const sf::FloatRect& rect1, const sf::FloatRect& rect2) const {
-    return rect1.findIntersection(rect2).has_value();
-}
@@ -0,0 +1,173 @@
+#include "include/LevelCheck.h"
+#include <cstring>
+#include <fstream>
+
+namespace LevelCheck {
+
+namespace {
+
+// Tile IDs of every code of up to three digits, by length and then value:
+// "" at 0, "0"-"9" from 1, "00"-"99" from 11, "000"-"999" from 111
+constexpr std::size_t SLOT_BASES[] = {0, 1, 11, 111};
+constexpr std::size_t SLOTS = 1111;
+
+struct CodeTable {
+    TileId ids[SLOTS];
+
+    CodeTable() {
+        char code[3];
+        for (std::size_t length = 0; length <= 3; ++length) {
+            const std::size_t count = SLOT_BASES[length] * 9 + 1;   // 10^length
+            for (std::size_t value = 0; value < count; ++value) {
+                std::size_t rest = value;
+                for (std::size_t i = length; i-- > 0; rest /= 10) code[i] = static_cast<char>('0' + rest % 10);
+                ids[SLOT_BASES[length] + value] = Tiles::parseTileCode(std::string_view(code, length));
+            }
+        }
+    }
+};
+
+const CodeTable CODES;
+
+}
+
+const char* issueName(Issue issue) {
+    switch (issue) {
+        case Issue::Empty:        return "empty";
+        case Issue::TooSmall:     return "too_small";
+        case Issue::SpawnBlocked: return "spawn_blocked";
+        case Issue::RaggedRows:   return "ragged_rows";
+        case Issue::UnknownCodes: return "unknown_codes";
+        case Issue::NoHazards:    return "no_hazards";
+        default:                  return "?";
+    }
+}
+
+bool isError(Issue issue) {
+    return issue == Issue::Empty || issue == Issue::TooSmall || issue == Issue::SpawnBlocked;
+}
+
+bool Result::has(Issue issue) const {
+    return (issues & (1u << static_cast<unsigned>(issue))) != 0;
+}
+
+bool Result::passed() const {
+    for (unsigned i = 0; i < static_cast<unsigned>(Issue::COUNT); ++i) {
+        if (isError(static_cast<Issue>(i)) && has(static_cast<Issue>(i))) return false;
+    }
+    return true;
+}
+
+Result check(std::string_view text, std::vector<TileId>* tiles, std::vector<std::size_t>* rowStarts) {
+    Result result;
+    if (tiles) tiles->clear();
+    if (rowStarts) rowStarts->clear();
+
+    // The cells under the spawn rects are picked up on the way past;
+    // the first non-empty one is kept
+    struct CellSpan {
+        int first;
+        int last;
+        bool contains(int cell) const { return cell >= first && cell <= last; }
+    };
+    CellSpan spawnRows[SPAWN_COUNT];
+    CellSpan spawnColumns[SPAWN_COUNT];
+    for (std::size_t i = 0; i < SPAWN_COUNT; ++i) {
+        const Rect& spawn = SPAWN_RECTS[i];
+        spawnRows[i] = {spawn.y / TILE_SIZE, (spawn.y + spawn.height - 1) / TILE_SIZE};
+        spawnColumns[i] = {spawn.x / TILE_SIZE, (spawn.x + spawn.width - 1) / TILE_SIZE};
+        result.spawnTiles[i] = Tiles::EMPTY;
+    }
+
+    int firstWidth = -1;
+    const char* next = text.data();
+    const char* end = next + text.size();
+
+    while (next < end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(next, '\n', end - next));
+        if (!lineEnd) lineEnd = end;
+        std::string_view line(next, lineEnd - next);
+        next = lineEnd + 1;
+
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        if (line.empty()) continue;
+
+        if (rowStarts) rowStarts->push_back(tiles ? tiles->size() : 0);
+        bool spawnRow = false;
+        for (const CellSpan& spawn : spawnRows) spawnRow |= spawn.contains(result.rows);
+
+        // One pass over the characters: digits are summed up as they go by,
+        // anything else is looked up by name when its cell ends
+        int width = 0;
+        const char* cell = line.data();
+        const char* rowEnd = line.data() + line.size();
+        std::size_t value = 0;
+        bool digits = true;
+        for (const char* c = cell; ; ++c) {
+            if (c < rowEnd && *c != ',') {
+                value = value * 10 + static_cast<std::size_t>(*c - '0');
+                digits = digits && *c >= '0' && *c <= '9';
+                continue;
+            }
+
+            std::size_t length = static_cast<std::size_t>(c - cell);
+            TileId tile = (digits && length <= 3) ? CODES.ids[SLOT_BASES[length] + value]
+                                                  : Tiles::parseTileCode(std::string_view(cell, length));
+            ++result.tileCounts[tile];
+            if (tiles) tiles->push_back(tile);
+
+            for (std::size_t i = 0; spawnRow && tile != Tiles::EMPTY && i < SPAWN_COUNT; ++i) {
+                if (result.spawnTiles[i] == Tiles::EMPTY && spawnRows[i].contains(result.rows) &&
+                    spawnColumns[i].contains(width)) {
+                    result.spawnTiles[i] = tile;
+                }
+            }
+            ++width;
+
+            if (c == rowEnd) break;
+            cell = c + 1;
+            value = 0;
+            digits = true;
+        }
+
+        if (firstWidth < 0) firstWidth = width;
+        if (width != firstWidth) ++result.raggedRows;
+        if (width > result.columns) result.columns = width;
+        ++result.rows;
+    }
+
+    auto flag = [&result](Issue issue) { result.issues |= 1u << static_cast<unsigned>(issue); };
+
+    if (result.rows == 0) flag(Issue::Empty);
+    if (result.rows > 0 && (result.rows < MIN_ROWS || result.columns < MIN_COLUMNS)) flag(Issue::TooSmall);
+    if (result.raggedRows > 0) flag(Issue::RaggedRows);
+    if (result.tileCounts[Tiles::UNKNOWN] > 0) flag(Issue::UnknownCodes);
+    if (result.rows > 0 && result.tileCounts[Tiles::LAVA] == 0 && result.tileCounts[Tiles::WATER] == 0) {
+        flag(Issue::NoHazards);
+    }
+
+    // Short rows are padded with empty space, so cells past the end of
+    // their row but inside the map are fine
+    for (std::size_t i = 0; i < SPAWN_COUNT; ++i) {
+        if (spawnRows[i].last >= result.rows || spawnColumns[i].last >= result.columns) {
+            result.spawnTiles[i] = OUTSIDE;
+        }
+        if (result.rows > 0 && result.spawnTiles[i] != Tiles::EMPTY) flag(Issue::SpawnBlocked);
+    }
+
+    return result;
+}
+
+bool readFile(const std::string& path, std::vector<char>& buffer) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) return false;
+
+    std::streamsize size = file.tellg();
+    if (size < 0) return false;
+    file.seekg(0);
+
+    buffer.resize(static_cast<std::size_t>(size));
+    return static_cast<bool>(file.read(buffer.data(), size));
+}
+
+}
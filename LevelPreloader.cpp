@@ -0,0 +1,103 @@
+#include "include/LevelPreloader.h"
+#include "include/Character.h"
+#include "include/Doors.h"
+#include "include/Gates.h"
+#include "include/ResourceCache.h"
+#include "include/Log.h"
+#include "include/Simulation.h"
+
+LevelPreloader::LevelPreloader()
+    : m_requestedLevel(0),
+      m_parsingLevel(0),
+      m_readyLevel(0),
+      m_stopping(false)
+{
+    m_thread = std::thread(&LevelPreloader::run, this);
+}
+
+LevelPreloader::~LevelPreloader() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    m_thread.join();
+}
+
+void LevelPreloader::request(int levelNumber) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_requestedLevel == levelNumber) return;
+        m_requestedLevel = levelNumber;
+    }
+    m_wake.notify_all();
+}
+
+std::unique_ptr<Board> LevelPreloader::take(int levelNumber) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    // Finishing a parse that is under way beats starting another one
+    m_parsed.wait(lock, [&] { return m_parsingLevel != levelNumber; });
+
+    // Either handed over now or loaded by the caller; asking for this level
+    // again parses it afresh
+    if (m_requestedLevel == levelNumber) m_requestedLevel = 0;
+    if (m_readyLevel != levelNumber) return nullptr;
+
+    m_readyLevel = 0;
+    return std::move(m_ready);
+}
+
+void LevelPreloader::run() {
+    // Every level uses the same images, so this is only needed once
+    decodeImages();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_wake.wait(lock, [this] {
+            return m_stopping || (m_requestedLevel != 0 && m_requestedLevel != m_readyLevel);
+        });
+        if (m_stopping) return;
+
+        int level = m_requestedLevel;
+        m_parsingLevel = level;
+        lock.unlock();
+
+        sf::Clock clock;
+        auto board = std::make_unique<Board>(Simulation::getLevelPath(level));
+        LOG_DEBUG(LogCategory::Level, "[PRELOAD] Level " << level << " parsed in "
+                  << clock.getElapsedTime().asMicroseconds() << " us");
+
+        lock.lock();
+        m_parsingLevel = 0;
+        m_ready = std::move(board);
+        m_readyLevel = level;
+        m_parsed.notify_all();
+    }
+}
+
+void LevelPreloader::decodeImages() {
+    std::vector<std::string> paths = Board::getImagePaths();
+    for (const auto& list : {Character::getImagePaths(), Doors::getImagePaths(), Gates::getImagePaths()}) {
+        paths.insert(paths.end(), list.begin(), list.end());
+    }
+
+    sf::Clock clock;
+    std::size_t decoded = 0;
+    for (const auto& path : paths) {
+        // Already on the GPU (the main thread got there first)
+        if (TextureCache::instance().contains(path)) continue;
+        ImageCache::instance().get(path);
+
+        // The texture may have been started while we decoded. It then has
+        // its own pixels and will never release this copy, so drop it here.
+        // A texture started after this check finds the copy and releases it.
+        if (TextureCache::instance().contains(path)) {
+            ImageCache::instance().release(path);
+            continue;
+        }
+        ++decoded;
+    }
+    LOG_DEBUG(LogCategory::Level, "[PRELOAD] " << decoded << " images decoded in "
+              << clock.getElapsedTime().asMilliseconds() << " ms");
+}
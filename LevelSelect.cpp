@@ -1,4 +1,5 @@
 #include "include/LevelSelect.h"
+#include "include/ResourceCache.h"
 #include <iostream>
 
 LevelSelect::LevelSelect()
@@ -8,22 +9,14 @@ LevelSelect::LevelSelect()
 }
 
 void LevelSelect::loadImages() {
-    if (!m_background.loadFromFile("data/screens/level_select_screen.png")) {
-        std::cerr << "Warning: Failed to load level select background" << std::endl;
-    }
-    m_backgroundSprite.emplace(m_background);
+    m_background = TextureCache::instance().get("data/screens/level_select_screen.png");
+    m_backgroundSprite.emplace(*m_background);
 
     for (int i = 1; i <= 5; ++i) {
-        sf::Texture texture;
         std::string path = "data/screens/level" + std::to_string(i) + ".png";
-        if (!texture.loadFromFile(path)) {
-            std::cerr << "Warning: Failed to load level texture: " << path << std::endl;
-        }
-
-        // Inserting texture into the map first
-        m_levelTextures[i] = texture;
+        m_levelTextures[i] = TextureCache::instance().get(path);
 
-        m_levelSprites.emplace(i, sf::Sprite(m_levelTextures[i]));
+        m_levelSprites.emplace(i, sf::Sprite(*m_levelTextures[i]));
     }
 }
 
@@ -0,0 +1,430 @@
+#include "include/LevelSolver.h"
+#include "include/Replay.h"
+#include "include/Simulation.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+namespace {
+
+// Which players a search moves. A solo search holds every gate open and
+// stops once its player stands in its own open door; if even that is
+// impossible the level is too, and it costs far less than moving both.
+enum class Scope { Hot, Cold, Both };
+
+const std::uint8_t HOT_INPUTS = Replay::HOT_LEFT | Replay::HOT_RIGHT | Replay::HOT_JUMP;
+const std::uint8_t COLD_INPUTS = Replay::COLD_LEFT | Replay::COLD_RIGHT | Replay::COLD_JUMP;
+
+// What a search step does: one player's input, held for the whole step.
+// Plain waiting is in there too, for doors that need time to rise.
+// Jump is a key pressed at the start of the step and held to its end, as
+// Controller::sample sees it (stepInputs): the press counts until it has
+// been used, then holding does nothing more, so a held key never jumps
+// higher. A jump pressed mid-air still happens on landing.
+const std::uint8_t STEP_INPUTS[] = {
+    0,
+    Replay::HOT_LEFT, Replay::HOT_RIGHT, Replay::HOT_JUMP,
+    Replay::HOT_LEFT | Replay::HOT_JUMP, Replay::HOT_RIGHT | Replay::HOT_JUMP,
+    Replay::COLD_LEFT, Replay::COLD_RIGHT, Replay::COLD_JUMP,
+    Replay::COLD_LEFT | Replay::COLD_JUMP, Replay::COLD_RIGHT | Replay::COLD_JUMP
+};
+
+const std::uint8_t JUMP_INPUTS = Replay::HOT_JUMP | Replay::COLD_JUMP;
+
+// What a step's keys give on its `tick`th tick of `steps`, as sampled by
+// Controller. Jump is pressed on the first tick and let go on the last, so
+// the key is seen up between two presses; in between it only counts while
+// the press is unused.
+std::uint8_t stepInputs(const Simulation& simulation, std::uint8_t inputs, std::uint32_t tick, std::uint32_t steps) {
+    std::uint8_t jumps = inputs & JUMP_INPUTS;
+    if (tick > 0 && tick + 1 == steps) {
+        jumps = 0;
+    } else if (tick > 0) {
+        jumps &= Replay::pendingJumps(simulation);
+    }
+    return static_cast<std::uint8_t>((inputs & ~JUMP_INPUTS) | jumps);
+}
+
+// Inputs from the start, shared between every state reached through them
+struct PathStep {
+    std::shared_ptr<const PathStep> parent;
+    std::uint8_t inputs;
+    std::uint32_t jumpTicks;   // how long the jump stayed unused, from the start of the step
+};
+
+struct Task {
+    Simulation::Snapshot snapshot;
+    std::shared_ptr<const PathStep> path;
+    std::uint32_t ticks;
+    std::uint32_t distance;   // to the doors, see DistanceField
+};
+
+// Heap order: nearest the doors first, then fewest ticks
+bool expandsLater(const Task& a, const Task& b) {
+    if (a.distance != b.distance) return a.distance > b.distance;
+    return a.ticks > b.ticks;
+}
+
+// Cells from each grid cell to a door, moving through open cells the
+// player survives. Ignores gravity, so it is only a guide for which states
+// to expand first, not a judgement on what is reachable.
+class DistanceField {
+private:
+    int m_columns;
+    int m_rows;
+    std::vector<std::uint32_t> m_cells;
+
+public:
+    static constexpr std::uint32_t UNREACHABLE = std::numeric_limits<std::uint32_t>::max() / 4;
+
+    DistanceField(const Board& board, const sf::FloatRect& goal, std::uint8_t lethal)
+        : m_columns(board.getGridColumns()),
+          m_rows(board.getGridRows()),
+          m_cells(static_cast<std::size_t>(m_columns) * m_rows, UNREACHABLE)
+    {
+        const float chunk = static_cast<float>(Board::CHUNK_SIZE);
+        auto open = [&](int column, int row) {
+            return column >= 0 && row >= 0 && column < m_columns && row < m_rows &&
+                   (Tiles::properties(board.getTile(column, row)).flags & (TILE_SOLID | lethal)) == 0;
+        };
+
+        // Breadth-first out from every open cell the goal covers
+        std::vector<std::pair<int, int>> frontier;
+        for (int row = static_cast<int>(goal.position.y / chunk);
+             row <= static_cast<int>((goal.position.y + goal.size.y - 1.0f) / chunk); ++row) {
+            for (int column = static_cast<int>(goal.position.x / chunk);
+                 column <= static_cast<int>((goal.position.x + goal.size.x - 1.0f) / chunk); ++column) {
+                if (!open(column, row)) continue;
+                m_cells[index(column, row)] = 0;
+                frontier.emplace_back(column, row);
+            }
+        }
+
+        const int offsets[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+        for (std::size_t next = 0; next < frontier.size(); ++next) {
+            auto [column, row] = frontier[next];
+            for (const auto& offset : offsets) {
+                int neighbourColumn = column + offset[0];
+                int neighbourRow = row + offset[1];
+                if (!open(neighbourColumn, neighbourRow)) continue;
+
+                std::uint32_t& distance = m_cells[index(neighbourColumn, neighbourRow)];
+                if (distance != UNREACHABLE) continue;
+                distance = m_cells[index(column, row)] + 1;
+                frontier.emplace_back(neighbourColumn, neighbourRow);
+            }
+        }
+    }
+
+    // From the cell under the middle of the rect
+    std::uint32_t at(const sf::FloatRect& rect) const {
+        const float chunk = static_cast<float>(Board::CHUNK_SIZE);
+        int column = static_cast<int>(std::floor((rect.position.x + rect.size.x / 2.0f) / chunk));
+        int row = static_cast<int>(std::floor((rect.position.y + rect.size.y / 2.0f) / chunk));
+        if (column < 0 || row < 0 || column >= m_columns || row >= m_rows) return UNREACHABLE;
+        return m_cells[index(column, row)];
+    }
+
+private:
+    std::size_t index(int column, int row) const {
+        return static_cast<std::size_t>(row) * m_columns + column;
+    }
+};
+
+constexpr float POSITION_STEP = 4.0f;
+
+void mix(std::uint64_t& hash, std::int64_t value) {
+    hash ^= static_cast<std::uint64_t>(value) + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+}
+
+bool moves(Scope scope, CharacterKind kind) {
+    return scope == Scope::Both || (scope == Scope::Hot) == (kind == CharacterKind::Hot);
+}
+
+// States this close are treated as the same: a few pixels of position, or
+// fall speed while standing, make no difference to where a player can get
+std::uint64_t stateKey(const Simulation& simulation, Scope scope) {
+    std::uint64_t hash = 0;
+    for (const auto& player : simulation.getPlayers()) {
+        if (!moves(scope, player.getKind())) continue;
+
+        Character::State state = player.saveState();
+        mix(hash, state.isAlive);
+        mix(hash, std::lround(state.rect.position.x / POSITION_STEP));
+        mix(hash, std::lround(state.rect.position.y / POSITION_STEP));
+        mix(hash, std::min(state.airTimer, 5));   // only < 5 matters, for jumping
+        if (state.airTimer > 0) mix(hash, std::lround(state.yVelocity));
+    }
+    for (const auto& door : simulation.getDoors()) {
+        Doors::State state = door.saveState();
+        mix(hash, state.isOpen);
+        mix(hash, std::lround(state.heightRaised));
+    }
+    for (const auto& gate : simulation.getGates()) mix(hash, gate.isOpen());
+    return hash;
+}
+
+// Solo searches pretend the other player is holding every plate
+void holdGatesOpen(Simulation& simulation, Scope scope) {
+    if (scope == Scope::Both) return;
+    for (auto& gate : simulation.getGates()) gate.setPressed(true);
+}
+
+bool reachedGoal(const Simulation& simulation, Scope scope) {
+    if (scope == Scope::Both) return simulation.getGameState() == GameState::Won;
+
+    const CharacterKind kind = (scope == Scope::Hot) ? CharacterKind::Hot : CharacterKind::Cold;
+    const Character* player = (scope == Scope::Hot) ? simulation.getHotPlayer() : simulation.getColdPlayer();
+    for (const auto& door : simulation.getDoors()) {
+        if (door.getOpener() == kind && door.isOpen() && player->getRect().findIntersection(door.getRect())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Every state ever queued, split so threads rarely wait on each other
+class VisitedSet {
+private:
+    static constexpr std::size_t SHARDS = 64;
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_set<std::uint64_t> keys;
+    };
+    Shard m_shards[SHARDS];
+
+public:
+    bool insert(std::uint64_t key) {
+        Shard& shard = m_shards[(key >> 58) % SHARDS];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.keys.insert(key).second;
+    }
+};
+
+// One per thread, a heap in expandsLater() order. Idle threads steal the
+// best task of another thread.
+struct WorkQueue {
+    std::mutex mutex;
+    std::vector<Task> tasks;
+};
+
+class Search {
+private:
+    const std::string& m_levelFile;
+    const LevelSolver::Options& m_options;
+    const Scope m_scope;
+    std::vector<std::uint8_t> m_stepInputs;
+    std::vector<WorkQueue> m_queues;
+    VisitedSet m_visited;
+    std::vector<DistanceField> m_hotFields;    // one per door, by opener
+    std::vector<DistanceField> m_coldFields;
+
+    std::atomic<std::size_t> m_pending;   // queued or being expanded
+    std::atomic<std::size_t> m_explored;
+    std::atomic<std::size_t> m_duplicates;
+    std::atomic<bool> m_finished;
+    std::atomic<bool> m_gaveUp;
+
+    std::mutex m_solutionMutex;
+    std::vector<std::uint8_t> m_solution;
+
+public:
+    Search(const std::string& levelFile, const LevelSolver::Options& options, unsigned int threads, Scope scope)
+        : m_levelFile(levelFile),
+          m_options(options),
+          m_scope(scope),
+          m_queues(threads),
+          m_pending(0),
+          m_explored(0),
+          m_duplicates(0),
+          m_finished(false),
+          m_gaveUp(false)
+    {
+        const std::uint8_t idle = (scope == Scope::Hot) ? COLD_INPUTS : (scope == Scope::Cold) ? HOT_INPUTS : 0;
+        for (std::uint8_t inputs : STEP_INPUTS) {
+            if ((inputs & idle) == 0) m_stepInputs.push_back(inputs);
+        }
+    }
+
+    // Adds its counts to `result`; sets the verdict, and the witness if found
+    void run(LevelSolver::Result& result) {
+        Simulation simulation;
+        simulation.loadLevel(m_levelFile);
+        holdGatesOpen(simulation, m_scope);
+        for (const auto& door : simulation.getDoors()) {
+            const Character* opener = (door.getOpener() == CharacterKind::Hot) ? simulation.getHotPlayer()
+                                                                               : simulation.getColdPlayer();
+            auto& fields = (door.getOpener() == CharacterKind::Hot) ? m_hotFields : m_coldFields;
+            fields.emplace_back(simulation.getBoard(), door.getTriggerZone(), opener->getLethalHazards());
+        }
+
+        m_visited.insert(stateKey(simulation, m_scope));
+        push(0, Task{simulation.saveSnapshot(), nullptr, 0, distanceToDoors(simulation)});
+
+        std::vector<std::thread> workers;
+        for (unsigned int i = 0; i < m_queues.size(); ++i) {
+            workers.emplace_back(&Search::work, this, i);
+        }
+        for (auto& worker : workers) worker.join();
+
+        result.statesExplored += m_explored;
+        result.duplicates += m_duplicates;
+        result.witness = std::move(m_solution);
+        if (!result.witness.empty()) {
+            result.verdict = LevelSolver::Verdict::Solved;
+        } else {
+            result.verdict = m_gaveUp ? LevelSolver::Verdict::GaveUp : LevelSolver::Verdict::NoSolution;
+        }
+    }
+
+private:
+    std::uint32_t distanceToDoors(const Simulation& simulation) const {
+        auto nearest = [](const std::vector<DistanceField>& fields, const Character* player) {
+            std::uint32_t best = DistanceField::UNREACHABLE;
+            for (const auto& field : fields) best = std::min(best, field.at(player->getRect()));
+            return best;
+        };
+        std::uint32_t distance = 0;
+        if (moves(m_scope, CharacterKind::Hot)) distance += nearest(m_hotFields, simulation.getHotPlayer());
+        if (moves(m_scope, CharacterKind::Cold)) distance += nearest(m_coldFields, simulation.getColdPlayer());
+        return distance;
+    }
+
+    void push(unsigned int queue, Task task) {
+        m_pending.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(m_queues[queue].mutex);
+        auto& tasks = m_queues[queue].tasks;
+        tasks.push_back(std::move(task));
+        std::push_heap(tasks.begin(), tasks.end(), expandsLater);
+    }
+
+    // Own queue first, then the others in turn
+    bool take(unsigned int self, Task& task) {
+        for (unsigned int i = 0; i < m_queues.size(); ++i) {
+            WorkQueue& queue = m_queues[(self + i) % m_queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty()) continue;
+
+            std::pop_heap(queue.tasks.begin(), queue.tasks.end(), expandsLater);
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            return true;
+        }
+        return false;
+    }
+
+    void work(unsigned int self) {
+        // Each thread steps its own copy of the level
+        Simulation simulation;
+        simulation.loadLevel(m_levelFile);
+
+        Task task;
+        while (!m_finished.load(std::memory_order_relaxed)) {
+            if (!take(self, task)) {
+                // Nothing anywhere and nobody expanding: the space is exhausted
+                if (m_pending.load() == 0) break;
+                std::this_thread::yield();
+                continue;
+            }
+            expand(self, simulation, task);
+            m_pending.fetch_sub(1);
+        }
+    }
+
+    void expand(unsigned int self, Simulation& simulation, const Task& task) {
+        const std::uint32_t steps = std::min<std::uint32_t>(m_options.ticksPerStep, m_options.maxTicks - task.ticks);
+        if (steps == 0) return;
+
+        for (std::uint8_t inputs : m_stepInputs) {
+            simulation.restoreSnapshot(task.snapshot);
+
+            std::uint32_t ticks = 0;
+            std::uint32_t jumpTicks = 0;
+            bool reached = false;
+            while (ticks < steps && simulation.getGameState() == GameState::Playing && !reached) {
+                const std::uint8_t applied = stepInputs(simulation, inputs, ticks, steps);
+                if (applied & JUMP_INPUTS) ++jumpTicks;
+
+                Replay::applyInputs(simulation, applied);
+                simulation.update();
+                holdGatesOpen(simulation, m_scope);
+                reached = reachedGoal(simulation, m_scope);
+                ++ticks;
+            }
+            auto path = std::make_shared<const PathStep>(PathStep{task.path, inputs, jumpTicks});
+
+            if (reached) {
+                finish(path, task.ticks + ticks);
+                return;
+            }
+            // Neither player can be spared
+            const Character* hot = simulation.getHotPlayer();
+            const Character* cold = simulation.getColdPlayer();
+            if (simulation.getGameState() != GameState::Playing || hot->isDead() || cold->isDead()) continue;
+
+            if (!m_visited.insert(stateKey(simulation, m_scope))) {
+                m_duplicates.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            if (m_explored.fetch_add(1, std::memory_order_relaxed) >= m_options.maxStates) {
+                m_gaveUp = true;
+                m_finished = true;
+                return;
+            }
+            push(self, Task{simulation.saveSnapshot(), std::move(path), task.ticks + ticks, distanceToDoors(simulation)});
+        }
+    }
+
+    void finish(const std::shared_ptr<const PathStep>& path, std::uint32_t ticks) {
+        std::lock_guard<std::mutex> lock(m_solutionMutex);
+        if (m_finished) return;   // someone else got there first
+        m_finished = true;
+
+        std::vector<const PathStep*> steps;
+        for (const PathStep* step = path.get(); step; step = step->parent.get()) steps.push_back(step);
+        std::reverse(steps.begin(), steps.end());
+
+        // Exactly what each tick applied: the jump bit only while it was unused
+        for (const PathStep* step : steps) {
+            for (std::uint32_t tick = 0; tick < static_cast<std::uint32_t>(m_options.ticksPerStep); ++tick) {
+                const bool jumping = tick < step->jumpTicks;
+                m_solution.push_back(jumping ? step->inputs : static_cast<std::uint8_t>(step->inputs & ~JUMP_INPUTS));
+            }
+        }
+        m_solution.resize(ticks);   // the last step won part-way through
+    }
+};
+
+}
+
+LevelSolver::Result LevelSolver::solve(const std::string& levelFile, const Options& options) {
+    Result result;
+    result.threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Each player alone first, with the gates out of the way
+    for (Scope scope : {Scope::Hot, Scope::Cold}) {
+        Search solo(levelFile, options, result.threads, scope);
+        solo.run(result);
+        if (result.verdict != Verdict::Solved) {
+            result.stuckPlayer = (scope == Scope::Hot) ? "hot" : "cold";
+            break;
+        }
+    }
+
+    if (result.verdict == Verdict::Solved) {
+        result.witness.clear();
+        Search both(levelFile, options, result.threads, Scope::Both);
+        both.run(result);
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
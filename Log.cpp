@@ -0,0 +1,237 @@
+#include "include/Log.h"
+#include <cstdio>
+#include <cstring>
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+const char* Logger::categoryName(LogCategory category) {
+    switch (category) {
+        case LogCategory::General:  return "general";
+        case LogCategory::Level:    return "level";
+        case LogCategory::Physics:  return "physics";
+        case LogCategory::Door:     return "door";
+        case LogCategory::Gate:     return "gate";
+        case LogCategory::Replay:   return "replay";
+        case LogCategory::Resource: return "resource";
+        case LogCategory::Input:    return "input";
+        case LogCategory::COUNT:    break;
+    }
+    return "?";
+}
+
+Logger::Logger()
+    : m_cells(std::make_unique<std::array<Cell, CAPACITY>>()),
+      m_enqueuePos(0),
+      m_dequeuePos(0),
+      m_minimumLevel(static_cast<std::uint8_t>(LogLevel::Debug)),
+      m_categoryMask(0xFFFFFFFFu),
+      m_dropped(0),
+      m_writerAsleep(false),
+      m_writtenCount(0),
+      m_stopping(false)
+{
+    for (std::size_t i = 0; i < CAPACITY; ++i) {
+        (*m_cells)[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    m_thread = std::thread(&Logger::run, this);
+}
+
+// Static destruction: whatever is still queued gets written first
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+}
+
+bool Logger::isEnabled(LogLevel level, LogCategory category) const {
+    if (static_cast<std::uint8_t>(level) < m_minimumLevel.load(std::memory_order_relaxed)) return false;
+    return (m_categoryMask.load(std::memory_order_relaxed) >> static_cast<unsigned>(category)) & 1u;
+}
+
+void Logger::setMinimumLevel(LogLevel level) {
+    m_minimumLevel.store(static_cast<std::uint8_t>(level), std::memory_order_relaxed);
+}
+
+void Logger::setCategoryEnabled(LogCategory category, bool enabled) {
+    std::uint32_t bit = 1u << static_cast<unsigned>(category);
+    if (enabled) {
+        m_categoryMask.fetch_or(bit, std::memory_order_relaxed);
+    } else {
+        m_categoryMask.fetch_and(~bit, std::memory_order_relaxed);
+    }
+}
+
+// A cell is free for position p when its sequence is p, and holds p's
+// record once the sequence is p + 1. No locks and no waiting, except that
+// the first message after the writer went to sleep wakes it up.
+void Logger::push(const LogRecord& record) {
+    std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = (*m_cells)[pos & (CAPACITY - 1)];
+        std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+
+        if (diff == 0) {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.record = record;
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                wakeWriter();
+                return;
+            }
+        } else if (diff < 0) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);   // full
+            return;
+        } else {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// Pairs with the fence in run(): either the writer sees the new record
+// before sleeping, or this sees it asleep. The lock makes sure the notify
+// can't land between the writer's last check and its wait.
+void Logger::wakeWriter() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!m_writerAsleep.load(std::memory_order_relaxed)) return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_wake.notify_one();
+}
+
+bool Logger::isEmpty() const {
+    const Cell& cell = (*m_cells)[m_dequeuePos & (CAPACITY - 1)];
+    return static_cast<std::ptrdiff_t>(cell.sequence.load(std::memory_order_acquire) - (m_dequeuePos + 1)) < 0;
+}
+
+bool Logger::pop(LogRecord& record) {
+    Cell& cell = (*m_cells)[m_dequeuePos & (CAPACITY - 1)];
+    std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    if (static_cast<std::ptrdiff_t>(sequence - (m_dequeuePos + 1)) < 0) return false;
+
+    record = cell.record;
+    cell.sequence.store(m_dequeuePos + CAPACITY, std::memory_order_release);
+    ++m_dequeuePos;
+    return true;
+}
+
+void Logger::flush() {
+    std::size_t target = m_enqueuePos.load(std::memory_order_acquire);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_wake.notify_one();
+    m_written.wait(lock, [&] { return m_writtenCount >= target; });
+}
+
+std::size_t Logger::getDropped() const {
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+void Logger::run() {
+    LogRecord record;
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    for (;;) {
+        bool stopping = m_stopping;
+        lock.unlock();
+
+        std::size_t count = 0;
+        while (pop(record)) {
+            write(record);
+            ++count;
+        }
+
+        if (std::size_t dropped = m_dropped.exchange(0, std::memory_order_relaxed)) {
+            std::fprintf(stderr, "Warning: %zu log messages dropped (buffer full)\n", dropped);
+        }
+
+        // One flush per batch instead of one per line
+        if (count > 0) {
+            std::fflush(stdout);
+            std::fflush(stderr);
+        }
+
+        lock.lock();
+        if (count > 0) {
+            m_writtenCount += count;
+            m_written.notify_all();
+            continue;
+        }
+        if (stopping) return;
+
+        // Nothing queued: sleep until a push, flush() or shutdown wakes us
+        // rather than polling, so an idle game has no wake-ups from here.
+        // Drops need no timer either: they only happen while the buffer is
+        // full, and then we are awake draining it.
+        m_writerAsleep.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (isEmpty() && !m_stopping) m_wake.wait(lock);
+        m_writerAsleep.store(false, std::memory_order_relaxed);
+    }
+}
+
+void Logger::write(const LogRecord& record) {
+    switch (record.level) {
+        case LogLevel::Debug:
+            std::fprintf(stdout, "[%s] %.*s\n", categoryName(record.category), record.length, record.text);
+            break;
+        case LogLevel::Info:
+            std::fprintf(stdout, "%.*s\n", record.length, record.text);
+            break;
+        case LogLevel::Warning:
+            std::fprintf(stderr, "Warning: %.*s\n", record.length, record.text);
+            break;
+        case LogLevel::Error:
+        case LogLevel::Off:
+            std::fprintf(stderr, "Error: %.*s\n", record.length, record.text);
+            break;
+    }
+}
+
+LogLine::Buffer::Buffer(LogRecord& record)
+    : m_record(record),
+      m_truncated(false)
+{
+}
+
+bool LogLine::Buffer::isTruncated() const { return m_truncated; }
+
+LogLine::Buffer::int_type LogLine::Buffer::overflow(int_type ch) {
+    if (traits_type::eq_int_type(ch, traits_type::eof())) return traits_type::not_eof(ch);
+
+    char c = traits_type::to_char_type(ch);
+    xsputn(&c, 1);
+    return ch;
+}
+
+std::streamsize LogLine::Buffer::xsputn(const char* text, std::streamsize count) {
+    std::size_t room = LogRecord::MAX_TEXT - m_record.length;
+    std::size_t copied = std::min(room, static_cast<std::size_t>(count));
+    std::memcpy(m_record.text + m_record.length, text, copied);
+    m_record.length = static_cast<std::uint8_t>(m_record.length + copied);
+    if (copied < static_cast<std::size_t>(count)) m_truncated = true;
+
+    // Claim it all; the rest of a long message is dropped, not an error
+    return count;
+}
+
+LogLine::LogLine(LogLevel level, LogCategory category)
+    : m_record{level, category, 0, {}},
+      m_buffer(m_record),
+      m_stream(&m_buffer)
+{
+}
+
+LogLine::~LogLine() {
+    if (m_buffer.isTruncated()) {
+        std::memcpy(m_record.text + LogRecord::MAX_TEXT - 3, "...", 3);
+    }
+    Logger::instance().push(m_record);
+}
+
+std::ostream& LogLine::stream() { return m_stream; }
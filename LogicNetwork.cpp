@@ -0,0 +1,193 @@
+#include "include/LogicNetwork.h"
+#include "include/Board.h"
+#include <algorithm>
+#include <cmath>
+
+std::uint8_t LogicNetwork::kindMask(CharacterKind kind) {
+    return static_cast<std::uint8_t>(1u << static_cast<unsigned>(kind));
+}
+
+TriggerId LogicNetwork::addTrigger(const sf::FloatRect& volume, std::uint8_t acceptedKinds) {
+    TriggerId id = static_cast<TriggerId>(m_triggers.size());
+    m_triggers.push_back(Trigger{volume, acceptedKinds, 0, {}});
+
+    CellRange cells = cellsUnder(volume);
+    for (int y = cells.firstRow; y < cells.lastRow; ++y) {
+        for (int x = cells.firstColumn; x < cells.lastColumn; ++x) {
+            m_cellTriggers[cellKey(x, y)].push_back(id);
+        }
+    }
+
+    // Players need to look at their cells again
+    for (auto& state : m_playerStates) state.cells = STALE_CELLS;
+    return id;
+}
+
+ActuatorId LogicNetwork::addActuator(LogicOp op) {
+    ActuatorId id = static_cast<ActuatorId>(m_actuators.size());
+    m_actuators.push_back(Actuator{op, 0, 0, false});
+    return id;
+}
+
+void LogicNetwork::connect(TriggerId trigger, ActuatorId actuator) {
+    m_triggers[trigger].outputs.push_back(actuator);
+    ++m_actuators[actuator].inputCount;
+}
+
+void LogicNetwork::clear() {
+    m_triggers.clear();
+    m_actuators.clear();
+    m_cellTriggers.clear();
+    m_playerStates.clear();
+    m_changed.clear();
+}
+
+void LogicNetwork::reset() {
+    for (auto& trigger : m_triggers) trigger.occupants = 0;
+    for (auto& actuator : m_actuators) {
+        actuator.activeInputs = 0;
+        actuator.active = false;
+    }
+    m_playerStates.clear();
+    m_changed.clear();
+}
+
+LogicNetwork::State LogicNetwork::saveState() const {
+    State state;
+    state.occupants.reserve(m_triggers.size());
+    for (const auto& trigger : m_triggers) state.occupants.push_back(trigger.occupants);
+    return state;
+}
+
+void LogicNetwork::restoreState(const State& state, const std::vector<Character>& players) {
+    for (auto& actuator : m_actuators) actuator.activeInputs = 0;
+
+    for (std::size_t i = 0; i < m_triggers.size(); ++i) {
+        Trigger& trigger = m_triggers[i];
+        trigger.occupants = (i < state.occupants.size()) ? state.occupants[i] : 0;
+        if (trigger.occupants == 0) continue;
+
+        for (ActuatorId output : trigger.outputs) ++m_actuators[output].activeInputs;
+    }
+    for (auto& actuator : m_actuators) actuator.active = evaluate(actuator);
+
+    // The candidate lists update() would have left behind for these positions
+    m_playerStates.assign(players.size(), PlayerState{STALE_CELLS, {}});
+    const std::size_t count = std::min(players.size(), MAX_PLAYERS);
+    for (std::size_t i = 0; i < count; ++i) {
+        const Character& player = players[i];
+        PlayerState& playerState = m_playerStates[i];
+        playerState.cells = player.isDead() ? NO_CELLS : cellsUnder(player.getRect());
+        collectCandidates(playerState.cells, kindMask(player.getKind()), playerState.candidates);
+    }
+    m_changed.clear();
+}
+
+void LogicNetwork::update(const std::vector<Character>& players) {
+    m_changed.clear();
+
+    if (m_playerStates.size() != players.size()) {
+        // New player set: everyone starts outside everything
+        for (std::size_t i = 0; i < m_playerStates.size(); ++i) {
+            for (TriggerId trigger : m_playerStates[i].candidates) setOccupied(trigger, i, false);
+        }
+        m_playerStates.assign(players.size(), PlayerState{STALE_CELLS, {}});
+    }
+
+    std::vector<TriggerId> candidates;
+    const std::size_t count = std::min(players.size(), MAX_PLAYERS);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const Character& player = players[i];
+        PlayerState& state = m_playerStates[i];
+        sf::FloatRect rect = player.getRect();
+
+        CellRange cells = player.isDead() ? NO_CELLS : cellsUnder(rect);
+        if (!(cells == state.cells)) {
+            candidates.clear();
+            collectCandidates(cells, kindMask(player.getKind()), candidates);
+
+            // Left the cells of these entirely
+            for (TriggerId trigger : state.candidates) {
+                if (std::find(candidates.begin(), candidates.end(), trigger) == candidates.end()) {
+                    setOccupied(trigger, i, false);
+                }
+            }
+
+            state.cells = cells;
+            state.candidates.swap(candidates);
+        }
+
+        for (TriggerId trigger : state.candidates) {
+            setOccupied(trigger, i, rect.findIntersection(m_triggers[trigger].volume).has_value());
+        }
+    }
+}
+
+bool LogicNetwork::isActive(ActuatorId actuator) const { return m_actuators[actuator].active; }
+bool LogicNetwork::isTriggered(TriggerId trigger) const { return m_triggers[trigger].occupants != 0; }
+const std::vector<ActuatorId>& LogicNetwork::getChangedActuators() const { return m_changed; }
+
+// Cells a rect overlaps with positive area, [first, last)
+LogicNetwork::CellRange LogicNetwork::cellsUnder(const sf::FloatRect& rect) {
+    const float chunk = static_cast<float>(Board::CHUNK_SIZE);
+    return CellRange{
+        static_cast<int>(std::floor(rect.position.x / chunk)),
+        static_cast<int>(std::ceil((rect.position.x + rect.size.x) / chunk)),
+        static_cast<int>(std::floor(rect.position.y / chunk)),
+        static_cast<int>(std::ceil((rect.position.y + rect.size.y) / chunk))
+    };
+}
+
+bool LogicNetwork::evaluate(const Actuator& actuator) {
+    if (actuator.op == LogicOp::Or) return actuator.activeInputs > 0;
+    return actuator.inputCount > 0 && actuator.activeInputs == actuator.inputCount;
+}
+
+std::uint64_t LogicNetwork::cellKey(int column, int row) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(column)) << 32) |
+           static_cast<std::uint32_t>(row);
+}
+
+void LogicNetwork::collectCandidates(const CellRange& cells, std::uint8_t kind, std::vector<TriggerId>& out) const {
+    if (m_cellTriggers.empty()) return;
+
+    for (int y = cells.firstRow; y < cells.lastRow; ++y) {
+        for (int x = cells.firstColumn; x < cells.lastColumn; ++x) {
+            auto it = m_cellTriggers.find(cellKey(x, y));
+            if (it == m_cellTriggers.end()) continue;
+
+            for (TriggerId trigger : it->second) {
+                if ((m_triggers[trigger].acceptedKinds & kind) == 0) continue;
+                if (std::find(out.begin(), out.end(), trigger) == out.end()) out.push_back(trigger);
+            }
+        }
+    }
+}
+
+void LogicNetwork::setOccupied(TriggerId id, std::size_t player, bool inside) {
+    Trigger& trigger = m_triggers[id];
+    const std::uint32_t bit = 1u << player;
+
+    bool wasOn = trigger.occupants != 0;
+    trigger.occupants = inside ? (trigger.occupants | bit) : (trigger.occupants & ~bit);
+    bool isOn = trigger.occupants != 0;
+    if (wasOn == isOn) return;
+
+    for (ActuatorId output : trigger.outputs) {
+        Actuator& actuator = m_actuators[output];
+        actuator.activeInputs = isOn ? actuator.activeInputs + 1 : actuator.activeInputs - 1;
+
+        bool active = evaluate(actuator);
+        if (active == actuator.active) continue;
+
+        actuator.active = active;
+        // Flipped back within the same update: drop the first report
+        auto seen = std::find(m_changed.begin(), m_changed.end(), output);
+        if (seen != m_changed.end()) {
+            m_changed.erase(seen);
+        } else {
+            m_changed.push_back(output);
+        }
+    }
+}
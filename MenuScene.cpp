@@ -0,0 +1,107 @@
+#include "include/MenuScene.h"
+#include "include/Game.h"
+#include "include/LevelPreloader.h"
+#include "include/Log.h"
+
+namespace {
+constexpr float SCREEN_CENTRE = 320.0f;
+constexpr float OPTIONS_TOP = 150.0f;      // Distance from top
+constexpr float OPTION_SPACING = 50.0f;    // Space between buttons
+}
+
+MenuScene::MenuScene(SceneStack& stack, SceneContext& context)
+    : m_stack(stack),
+      m_context(context),
+      m_selectedOption(0),
+      m_text(context.font)
+{
+    using Align = TextBatch::Align;
+
+    m_text.add("HOT AND COLD", sf::Vector2f(SCREEN_CENTRE, 40), 48, sf::Color::Yellow, true, Align::Center);
+    m_text.add("Select a Level", sf::Vector2f(SCREEN_CENTRE, 120), 24, sf::Color(200, 200, 200), false, Align::Center);
+
+    // Menu options - Level 1-5 + Quit
+    for (int i = 0; i < OPTION_COUNT; ++i) {
+        std::string name = (i < LEVEL_COUNT) ? "Level " + std::to_string(i + 1) : "Quit";
+        sf::Vector2f position(SCREEN_CENTRE, OPTIONS_TOP + i * OPTION_SPACING);
+        m_optionLabels.push_back(m_text.add(name, position, 28, sf::Color(180, 180, 180), false, Align::Center));
+    }
+
+    // Selection indicator
+    m_arrowLabel = m_text.add(">", sf::Vector2f(180, OPTIONS_TOP), 28);
+
+    m_text.add("Use UP/DOWN to navigate, ENTER to select", sf::Vector2f(SCREEN_CENTRE, 450), 16,
+               sf::Color(150, 150, 150), false, Align::Center);
+
+    select(0);
+}
+
+void MenuScene::onActivate() {
+    m_context.window.setTitle("Hot and Cold");
+
+    // After a win the next level is highlighted (the game already asked
+    // for it to be preloaded). select() un-highlights the current option,
+    // so it must not be moved beforehand.
+    int option = m_selectedOption;
+    if (m_context.lastWonLevel > 0 && m_context.lastWonLevel < LEVEL_COUNT) {
+        option = m_context.lastWonLevel;
+    }
+    m_context.lastWonLevel = 0;
+
+    select(option);
+}
+
+void MenuScene::select(int option) {
+    TextBatch::LabelId previous = m_optionLabels[m_selectedOption];
+    m_text.setColor(previous, sf::Color(180, 180, 180));
+    m_text.setBold(previous, false);
+
+    m_selectedOption = option;
+
+    TextBatch::LabelId current = m_optionLabels[m_selectedOption];
+    m_text.setColor(current, sf::Color::White);
+    m_text.setBold(current, true);
+    m_text.setPosition(m_arrowLabel, sf::Vector2f(180, OPTIONS_TOP + m_selectedOption * OPTION_SPACING));
+    invalidate();
+
+    // Parse the highlighted level in the background so Enter starts it
+    // straight away
+    if (m_selectedOption < LEVEL_COUNT) m_context.preloader.request(m_selectedOption + 1);
+}
+
+void MenuScene::handleEvent(const sf::Event& event) {
+    const auto* keyPressed = event.getIf<sf::Event::KeyPressed>();
+    if (!keyPressed) return;
+
+    switch (keyPressed->code) {
+        case sf::Keyboard::Key::Up:
+            select((m_selectedOption - 1 + OPTION_COUNT) % OPTION_COUNT);
+            break;
+        case sf::Keyboard::Key::Down:
+            select((m_selectedOption + 1) % OPTION_COUNT);
+            break;
+        case sf::Keyboard::Key::Enter:
+            if (m_selectedOption < LEVEL_COUNT) {
+                int level = m_selectedOption + 1;
+                LOG_INFO(LogCategory::Level, "\nStarting Level " << level << "...");
+                m_stack.push(std::make_unique<Game>(m_stack, m_context, level));
+            } else {
+                m_stack.clear();   // Quit
+            }
+            break;
+        case sf::Keyboard::Key::Escape:
+            m_stack.clear();
+            break;
+        default:
+            break;
+    }
+}
+
+void MenuScene::update(sf::Time) {}
+
+bool MenuScene::isEventDriven() const { return true; }
+
+void MenuScene::draw(sf::RenderTarget& target) {
+    target.clear(sf::Color(20, 20, 40));
+    target.draw(m_text);
+}
@@ -0,0 +1,77 @@
+#include "include/Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+Profiler::Profiler()
+    : m_current{},
+      m_history{},
+      m_head(0),
+      m_frames(0)
+{
+}
+
+Profiler& Profiler::instance() {
+    static thread_local Profiler profiler;
+    return profiler;
+}
+
+const char* Profiler::phaseName(Phase phase) {
+    switch (phase) {
+        case Phase::Frame:      return "frame";
+        case Phase::Events:     return "events";
+        case Phase::Update:     return "update";
+        case Phase::Movement:   return "  movement";
+        case Phase::Death:      return "  death";
+        case Phase::DoorsGates: return "  doors/gates";
+        case Phase::Draw:       return "draw";
+        case Phase::DrawBoard:  return "  board";
+        case Phase::Display:    return "  display";
+        case Phase::COUNT:      break;
+    }
+    return "?";
+}
+
+void Profiler::add(Phase phase, float microseconds) {
+    m_current[static_cast<std::size_t>(phase)] += microseconds;
+}
+
+void Profiler::endFrame() {
+    for (std::size_t i = 0; i < PHASE_COUNT; ++i) {
+        m_history[i][m_head] = m_current[i];
+        m_current[i] = 0.0f;
+    }
+    m_head = (m_head + 1) % HISTORY;
+    m_frames = std::min(m_frames + 1, HISTORY);
+}
+
+Profiler::Stats Profiler::getStats(Phase phase) const {
+    Stats stats{0.0f, 0.0f, 0.0f};
+    if (m_frames == 0) return stats;
+
+    std::vector<float> samples;
+    samples.reserve(m_frames);
+    for (std::size_t i = 0; i < m_frames; ++i) {
+        samples.push_back(getSample(phase, i));
+    }
+
+    stats.current = samples.front();
+
+    float total = 0.0f;
+    for (float sample : samples) total += sample;
+    stats.average = total / static_cast<float>(samples.size());
+
+    std::size_t rank = static_cast<std::size_t>(std::ceil(0.99 * static_cast<double>(samples.size()))) - 1;
+    std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+    stats.p99 = samples[rank];
+
+    return stats;
+}
+
+float Profiler::getSample(Phase phase, std::size_t framesAgo) const {
+    if (framesAgo >= m_frames) return 0.0f;
+    std::size_t slot = (m_head + HISTORY - 1 - framesAgo) % HISTORY;
+    return m_history[static_cast<std::size_t>(phase)][slot];
+}
+
+std::size_t Profiler::getFrameCount() const { return m_frames; }
@@ -0,0 +1,83 @@
+#include "include/ProfilerHud.h"
+#include "include/Profiler.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+const sf::Vector2f PANEL_POSITION(4.0f, 4.0f);
+const sf::Vector2f PANEL_SIZE(260.0f, 236.0f);
+constexpr unsigned int TEXT_SIZE = 11;
+
+// Graph: one column per frame in history, newest on the right
+constexpr float GRAPH_HEIGHT = 60.0f;
+constexpr float GRAPH_SCALE_US = 33333.0f;   // top of the graph = 30 FPS
+constexpr float BUDGET_US = 1000000.0f / 60.0f;
+
+float graphY(float microseconds) {
+    float bottom = PANEL_POSITION.y + PANEL_SIZE.y - 8.0f;
+    return bottom - std::min(microseconds / GRAPH_SCALE_US, 1.0f) * GRAPH_HEIGHT;
+}
+
+void appendLine(sf::VertexArray& lines, sf::Vector2f from, sf::Vector2f to, sf::Color color) {
+    lines.append(sf::Vertex{from, color, sf::Vector2f()});
+    lines.append(sf::Vertex{to, color, sf::Vector2f()});
+}
+
+}
+
+ProfilerHud::ProfilerHud(const sf::Font& font)
+    : m_font(font),
+      m_visible(false),
+      m_graph(sf::PrimitiveType::Lines)
+{
+}
+
+void ProfilerHud::toggle() { m_visible = !m_visible; }
+bool ProfilerHud::isVisible() const { return m_visible; }
+
+void ProfilerHud::update() {
+    const Profiler& profiler = Profiler::instance();
+
+    char line[96];
+    m_table = "phase            cur    avg    p99  (ms)\n";
+    for (std::size_t i = 0; i < Profiler::PHASE_COUNT; ++i) {
+        Phase phase = static_cast<Phase>(i);
+        Profiler::Stats stats = profiler.getStats(phase);
+        std::snprintf(line, sizeof(line), "%-14s %6.2f %6.2f %6.2f\n", Profiler::phaseName(phase),
+                      stats.current / 1000.0f, stats.average / 1000.0f, stats.p99 / 1000.0f);
+        m_table += line;
+    }
+
+    m_graph.clear();
+    float left = PANEL_POSITION.x + 10.0f;
+    float bottom = graphY(0.0f);
+
+    sf::Color budgetColor(255, 255, 255, 120);
+    appendLine(m_graph, sf::Vector2f(left, graphY(BUDGET_US)),
+               sf::Vector2f(left + Profiler::HISTORY, graphY(BUDGET_US)), budgetColor);
+
+    std::size_t frames = profiler.getFrameCount();
+    for (std::size_t ago = 0; ago < frames; ++ago) {
+        float frameTime = profiler.getSample(Phase::Frame, ago);
+        float x = left + static_cast<float>(Profiler::HISTORY - 1 - ago) + 0.5f;
+        sf::Color color = (frameTime > BUDGET_US) ? sf::Color(255, 80, 80) : sf::Color(80, 220, 80);
+        appendLine(m_graph, sf::Vector2f(x, bottom), sf::Vector2f(x, graphY(frameTime)), color);
+    }
+}
+
+void ProfilerHud::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    if (!m_visible) return;
+
+    sf::RectangleShape panel(PANEL_SIZE);
+    panel.setPosition(PANEL_POSITION);
+    panel.setFillColor(sf::Color(0, 0, 0, 180));
+    target.draw(panel, states);
+
+    sf::Text text(m_font, m_table, TEXT_SIZE);
+    text.setFillColor(sf::Color::White);
+    text.setPosition(PANEL_POSITION + sf::Vector2f(6.0f, 4.0f));
+    target.draw(text, states);
+
+    target.draw(m_graph, states);
+}
@@ -0,0 +1,207 @@
+#include "include/Replay.h"
+#include "include/Log.h"
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+// File layout, all integers little-endian:
+//   "HCRP" u8 version  u8 level  u32 ticks  u32 runs
+//   runs x { u8 inputs  u32 ticks }
+//   u8 state  f32 hotX hotY coldX coldY  u8 hotDead  u8 coldDead
+const char MAGIC[4] = {'H', 'C', 'R', 'P'};
+// Bumped whenever the physics change, since old inputs no longer reproduce
+// old outcomes (2: swept collision)
+const std::uint8_t VERSION = 2;
+
+void writeU8(std::ostream& out, std::uint8_t value) {
+    out.put(static_cast<char>(value));
+}
+
+void writeU32(std::ostream& out, std::uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+void writeF32(std::ostream& out, float value) {
+    static_assert(sizeof(float) == sizeof(std::uint32_t));
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeU32(out, bits);
+}
+
+bool readU8(std::istream& in, std::uint8_t& value) {
+    char c;
+    if (!in.get(c)) return false;
+    value = static_cast<std::uint8_t>(c);
+    return true;
+}
+
+bool readU32(std::istream& in, std::uint32_t& value) {
+    value = 0;
+    for (int i = 0; i < 4; ++i) {
+        std::uint8_t byte;
+        if (!readU8(in, byte)) return false;
+        value |= static_cast<std::uint32_t>(byte) << (8 * i);
+    }
+    return true;
+}
+
+bool readF32(std::istream& in, float& value) {
+    std::uint32_t bits;
+    if (!readU32(in, bits)) return false;
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+}
+
+Replay::Replay()
+    : m_level(0),
+      m_tickCount(0)
+{
+}
+
+void Replay::begin(int levelNumber) {
+    m_level = levelNumber;
+    m_tickCount = 0;
+    m_runs.clear();
+    m_outcome = Outcome();
+}
+
+void Replay::recordTick(std::uint8_t inputs) {
+    if (!m_runs.empty() && m_runs.back().inputs == inputs) {
+        ++m_runs.back().ticks;
+    } else {
+        m_runs.push_back(InputRun{inputs, 1});
+    }
+    ++m_tickCount;
+}
+
+void Replay::finish(const Simulation& simulation) {
+    m_outcome = captureOutcome(simulation);
+}
+
+bool Replay::saveToFile(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) {
+        LOG_WARNING(LogCategory::Replay, "could not write replay: " << path);
+        return false;
+    }
+
+    out.write(MAGIC, sizeof(MAGIC));
+    writeU8(out, VERSION);
+    writeU8(out, static_cast<std::uint8_t>(m_level));
+    writeU32(out, m_tickCount);
+    writeU32(out, static_cast<std::uint32_t>(m_runs.size()));
+    for (const auto& run : m_runs) {
+        writeU8(out, run.inputs);
+        writeU32(out, run.ticks);
+    }
+
+    writeU8(out, static_cast<std::uint8_t>(m_outcome.state));
+    writeF32(out, m_outcome.hotPosition.x);
+    writeF32(out, m_outcome.hotPosition.y);
+    writeF32(out, m_outcome.coldPosition.x);
+    writeF32(out, m_outcome.coldPosition.y);
+    writeU8(out, m_outcome.hotDead ? 1 : 0);
+    writeU8(out, m_outcome.coldDead ? 1 : 0);
+
+    return static_cast<bool>(out);
+}
+
+bool Replay::loadFromFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        LOG_ERROR(LogCategory::Replay, "Failed to open replay: " << path);
+        return false;
+    }
+
+    char magic[4];
+    std::uint8_t version, level, state, hotDead, coldDead;
+    std::uint32_t ticks, runCount;
+
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        !readU8(in, version) || version != VERSION) {
+        LOG_ERROR(LogCategory::Replay, "Not a replay file (or wrong version): " << path);
+        return false;
+    }
+
+    if (!readU8(in, level) || !readU32(in, ticks) || !readU32(in, runCount)) {
+        LOG_ERROR(LogCategory::Replay, "Truncated replay: " << path);
+        return false;
+    }
+
+    begin(level);
+    std::uint32_t total = 0;
+    for (std::uint32_t i = 0; i < runCount; ++i) {
+        InputRun run;
+        if (!readU8(in, run.inputs) || !readU32(in, run.ticks)) {
+            LOG_ERROR(LogCategory::Replay, "Truncated replay: " << path);
+            return false;
+        }
+        m_runs.push_back(run);
+        total += run.ticks;
+    }
+    m_tickCount = total;
+
+    if (!readU8(in, state) ||
+        !readF32(in, m_outcome.hotPosition.x) || !readF32(in, m_outcome.hotPosition.y) ||
+        !readF32(in, m_outcome.coldPosition.x) || !readF32(in, m_outcome.coldPosition.y) ||
+        !readU8(in, hotDead) || !readU8(in, coldDead)) {
+        LOG_ERROR(LogCategory::Replay, "Truncated replay: " << path);
+        return false;
+    }
+    m_outcome.state = static_cast<GameState>(state);
+    m_outcome.hotDead = hotDead != 0;
+    m_outcome.coldDead = coldDead != 0;
+
+    if (total != ticks) {
+        LOG_WARNING(LogCategory::Replay, "replay header says " << ticks << " ticks, runs add up to " << total);
+    }
+    return true;
+}
+
+int Replay::getLevel() const { return m_level; }
+std::uint32_t Replay::getTickCount() const { return m_tickCount; }
+const std::vector<Replay::InputRun>& Replay::getRuns() const { return m_runs; }
+const Replay::Outcome& Replay::getOutcome() const { return m_outcome; }
+
+// A jump stays set until the character uses it, so one pressed mid-air
+// still happens on landing
+std::uint8_t Replay::pendingJumps(const Simulation& simulation) {
+    std::uint8_t jumps = 0;
+    const Character* hot = simulation.getHotPlayer();
+    const Character* cold = simulation.getColdPlayer();
+    if (hot && hot->isJumping())   jumps |= HOT_JUMP;
+    if (cold && cold->isJumping()) jumps |= COLD_JUMP;
+    return jumps;
+}
+
+void Replay::applyInputs(Simulation& simulation, std::uint8_t inputs) {
+    if (Character* hot = simulation.getHotPlayer()) {
+        hot->setMovingRight((inputs & HOT_RIGHT) != 0);
+        hot->setMovingLeft((inputs & HOT_LEFT) != 0);
+        hot->setJumping((inputs & HOT_JUMP) != 0);
+    }
+    if (Character* cold = simulation.getColdPlayer()) {
+        cold->setMovingRight((inputs & COLD_RIGHT) != 0);
+        cold->setMovingLeft((inputs & COLD_LEFT) != 0);
+        cold->setJumping((inputs & COLD_JUMP) != 0);
+    }
+}
+
+Replay::Outcome Replay::captureOutcome(const Simulation& simulation) {
+    Outcome outcome;
+    outcome.state = simulation.getGameState();
+    if (const Character* hot = simulation.getHotPlayer()) {
+        outcome.hotPosition = hot->getRect().position;
+        outcome.hotDead = hot->isDead();
+    }
+    if (const Character* cold = simulation.getColdPlayer()) {
+        outcome.coldPosition = cold->getRect().position;
+        outcome.coldDead = cold->isDead();
+    }
+    return outcome;
+}
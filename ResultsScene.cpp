@@ -0,0 +1,53 @@
+#include "include/ResultsScene.h"
+#include "include/Game.h"
+#include "include/Log.h"
+
+ResultsScene::ResultsScene(SceneStack& stack, SceneContext& context, Game& game, bool won)
+    : m_stack(stack),
+      m_game(game),
+      m_won(won),
+      m_panel(sf::Vector2f(500, 200)),
+      m_text(context.font)
+{
+    m_panel.setPosition(sf::Vector2f(70, 140));
+    m_panel.setOutlineThickness(5.0f);
+
+    if (m_won) {
+        m_panel.setFillColor(sf::Color(0, 150, 0, 240));
+        m_panel.setOutlineColor(sf::Color(255, 215, 0));
+        m_text.add("LEVEL COMPLETE!", sf::Vector2f(150, 170), 36);
+    } else {
+        m_panel.setFillColor(sf::Color(150, 0, 0, 240));
+        m_panel.setOutlineColor(sf::Color::White);
+        m_text.add("GAME OVER", sf::Vector2f(210, 170), 36);
+    }
+
+    m_text.add("R: Restart  M/ESC: Menu", sf::Vector2f(180, 240), 18);
+}
+
+void ResultsScene::handleEvent(const sf::Event& event) {
+    const auto* keyPressed = event.getIf<sf::Event::KeyPressed>();
+    if (!keyPressed) return;
+
+    if (keyPressed->code == sf::Keyboard::Key::R) {
+        LOG_INFO(LogCategory::Level, "\n=== RESTARTING LEVEL ===");
+        m_game.restartLevel();
+        m_stack.pop();
+    } else if (keyPressed->code == sf::Keyboard::Key::M || keyPressed->code == sf::Keyboard::Key::Escape) {
+        LOG_INFO(LogCategory::Level, "\n=== RETURNING TO MAIN MENU ===");
+        m_stack.pop();   // this panel
+        m_stack.pop();   // the level
+    }
+}
+
+void ResultsScene::update(sf::Time) {}
+
+bool ResultsScene::isOverlay() const { return true; }
+
+// The level under the panel is frozen, so nothing moves until a key press
+bool ResultsScene::isEventDriven() const { return true; }
+
+void ResultsScene::draw(sf::RenderTarget& target) {
+    target.draw(m_panel);
+    target.draw(m_text);
+}
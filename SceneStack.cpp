@@ -0,0 +1,189 @@
+#include "include/SceneStack.h"
+#include "include/Log.h"
+#include "include/Profiler.h"
+#include <iomanip>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <ctime>
+#endif
+
+namespace {
+
+// CPU time of the whole process (all threads) so far
+sf::Time getProcessCpuTime() {
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) return sf::Time::Zero;
+
+    // 100 ns units
+    auto toMicroseconds = [](const FILETIME& time) {
+        return static_cast<std::int64_t>((static_cast<std::uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime) / 10;
+    };
+    return sf::microseconds(toMicroseconds(kernel) + toMicroseconds(user));
+#else
+    timespec time;
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time) != 0) return sf::Time::Zero;
+    return sf::microseconds(static_cast<std::int64_t>(time.tv_sec) * 1000000 + time.tv_nsec / 1000);
+#endif
+}
+
+}
+
+void SceneStack::push(std::unique_ptr<Scene> scene) {
+    m_pending.push_back(Change{Change::Type::Push, std::move(scene)});
+}
+
+void SceneStack::pop() {
+    m_pending.push_back(Change{Change::Type::Pop, nullptr});
+}
+
+void SceneStack::clear() {
+    m_pending.push_back(Change{Change::Type::Clear, nullptr});
+}
+
+bool SceneStack::isEmpty() const {
+    return m_scenes.empty() && m_pending.empty();
+}
+
+void SceneStack::run(sf::RenderWindow& window) {
+    if (applyPending()) activateTop();
+
+    sf::Clock frameClock;
+    while (window.isOpen() && !m_scenes.empty()) {
+        Scene& top = *m_scenes.back();
+        const bool eventDriven = top.isEventDriven();
+
+        // Nothing on screen can change until something happens: sleep in
+        // the OS rather than spinning through identical frames
+        if (eventDriven && !m_redrawPending && !top.m_invalidated) {
+            const sf::Time interval = top.getAnimationInterval();
+            if (const auto event = window.waitEvent(interval)) {
+                dispatchEvent(window, *event);
+            } else if (interval != sf::Time::Zero) {
+                m_redrawPending = true;   // animation step
+            }
+        }
+
+        bool drawn = false;
+        {
+            PROFILE_PHASE(Phase::Frame);
+
+            {
+                PROFILE_PHASE(Phase::Events);
+                // Once a change is pending the rest belong to whichever
+                // scene comes next
+                while (m_pending.empty() && window.isOpen()) {
+                    const auto event = window.pollEvent();
+                    if (!event) break;
+                    dispatchEvent(window, *event);
+                }
+            }
+            if (!window.isOpen()) break;
+
+            top.update(frameClock.restart());
+
+            if (!eventDriven || m_redrawPending || top.m_invalidated) {
+                draw(window);
+                m_redrawPending = false;
+                top.m_invalidated = false;
+                if (eventDriven) ++m_idle.redraws;
+                drawn = true;
+
+                PROFILE_PHASE(Phase::Display);
+                window.display();
+            }
+        }
+        if (drawn) PROFILE_END_FRAME();
+
+        if (applyPending()) {
+            // Time spent loading the new scene is not frame time
+            frameClock.restart();
+            if (!m_scenes.empty()) activateTop();
+        }
+    }
+    endIdleStretch();
+}
+
+bool SceneStack::applyPending() {
+    if (m_pending.empty()) return false;
+
+    for (auto& change : m_pending) {
+        switch (change.type) {
+            case Change::Type::Push:
+                m_scenes.push_back(std::move(change.scene));
+                break;
+            case Change::Type::Pop:
+                if (!m_scenes.empty()) m_scenes.pop_back();
+                break;
+            case Change::Type::Clear:
+                m_scenes.clear();
+                break;
+        }
+    }
+    m_pending.clear();
+    return true;
+}
+
+void SceneStack::activateTop() {
+    Scene& top = *m_scenes.back();
+    top.onActivate();
+    m_redrawPending = true;
+
+    if (top.isEventDriven()) {
+        beginIdleStretch();
+    } else {
+        endIdleStretch();
+    }
+}
+
+void SceneStack::dispatchEvent(sf::RenderWindow& window, const sf::Event& event) {
+    if (event.is<sf::Event::Closed>()) {
+        window.close();
+        return;
+    }
+    // The window contents may need painting again even though no scene changed
+    if (event.is<sf::Event::Resized>() || event.is<sf::Event::FocusGained>()) m_redrawPending = true;
+
+    m_scenes.back()->handleEvent(event);
+}
+
+// From the topmost opaque scene up, so overlays show what is beneath them
+void SceneStack::draw(sf::RenderWindow& window) {
+    window.clear(sf::Color::Black);
+
+    std::size_t first = m_scenes.size() - 1;
+    while (first > 0 && m_scenes[first]->isOverlay()) --first;
+
+    for (std::size_t i = first; i < m_scenes.size(); ++i) {
+        window.setView(window.getDefaultView());
+        m_scenes[i]->draw(window);
+    }
+}
+
+void SceneStack::beginIdleStretch() {
+    if (m_idle.active) return;
+
+    m_idle.active = true;
+    m_idle.wallClock.restart();
+    m_idle.cpuStart = getProcessCpuTime();
+    m_idle.redraws = 0;
+}
+
+void SceneStack::endIdleStretch() {
+    if (!m_idle.active) return;
+    m_idle.active = false;
+
+    [[maybe_unused]] const sf::Time wall = m_idle.wallClock.getElapsedTime();
+    [[maybe_unused]] const sf::Time cpu = getProcessCpuTime() - m_idle.cpuStart;
+
+    LOG_INFO(LogCategory::General, "[IDLE] " << std::fixed << std::setprecision(1) << wall.asSeconds()
+                                             << " s on menu screens, " << m_idle.redraws << " redraws, CPU "
+                                             << std::setprecision(2)
+                                             << (wall > sf::Time::Zero ? 100.0f * (cpu / wall) : 0.0f) << "%");
+}
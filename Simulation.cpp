@@ -0,0 +1,356 @@
+#include "include/Simulation.h"
+#include "include/Profiler.h"
+#include "include/Log.h"
+#include "include/LevelCheck.h"
+#include <algorithm>
+
+Simulation::Simulation()
+    : m_gameState(GameState::Playing),
+      m_currentLevel(0),
+      m_winLogged(false)
+{
+}
+
+Simulation::Simulation(int levelNumber) : Simulation() {
+    initializeLevel(levelNumber);
+}
+
+Simulation::~Simulation() {
+    cleanup();
+}
+
+std::string Simulation::getLevelPath(int levelNumber) {
+    return "data/level" + std::to_string(levelNumber) + ".txt";
+}
+
+void Simulation::initializeLevel(int levelNumber, std::unique_ptr<Board> board) {
+    m_currentLevel = levelNumber;
+
+    if (board) {
+        LOG_INFO(LogCategory::Level, "[LEVEL LOAD] Using preloaded level " << levelNumber);
+        setupLevel(std::move(board));
+    } else {
+        loadLevel(getLevelPath(levelNumber));
+    }
+}
+
+// Board from any map file, with the standard player/door/gate layout
+void Simulation::loadLevel(const std::string& levelFile) {
+    LOG_INFO(LogCategory::Level, "[LEVEL LOAD] Loading: " << levelFile);
+    setupLevel(std::make_unique<Board>(levelFile));
+}
+
+void Simulation::setupLevel(std::unique_ptr<Board> board) {
+    cleanup();
+
+    m_gameState = GameState::Playing;
+    m_board = std::move(board);
+
+    // Players start at bottom left and bottom right; LevelCheck checks the
+    // cells under these
+    const LevelCheck::Rect& hotSpawn = LevelCheck::SPAWN_RECTS[0];
+    const LevelCheck::Rect& coldSpawn = LevelCheck::SPAWN_RECTS[1];
+    m_hotPlayer = addPlayer(CharacterKind::Hot, sf::Vector2f(static_cast<float>(hotSpawn.x), static_cast<float>(hotSpawn.y)));
+    m_coldPlayer = addPlayer(CharacterKind::Cold, sf::Vector2f(static_cast<float>(coldSpawn.x), static_cast<float>(coldSpawn.y)));
+
+    // Doors at the top - using row 3 (y = 48) for proper positioning
+    // Doors at specific tile positions
+    addDoor(DoorKind::Fire, sf::Vector2f(2.0f * 16, 2.0f * 16));     // Row 2, Col 2
+    addDoor(DoorKind::Water, sf::Vector2f(35.0f * 16, 2.0f * 16));   // Row 2, Col 35
+
+    // Gate with proper button placement
+    // Left button, gate in middle, right button
+    // Left gate system
+    std::vector<sf::Vector2f> leftGateButtons = {
+        sf::Vector2f(6.0f * 16, 17.0f * 16),    // Button before gate
+        sf::Vector2f(14.0f * 16, 17.0f * 16)    // Button after gate
+    };
+    addGate(sf::Vector2f(10.0f * 16, 15.0f * 16), leftGateButtons);
+
+    // Right gate system
+    std::vector<sf::Vector2f> rightGateButtons = {
+        sf::Vector2f(25.0f * 16, 17.0f * 16),
+        sf::Vector2f(33.0f * 16, 23.0f * 16)
+    };
+    addGate(sf::Vector2f(29.0f * 16, 15.0f * 16), rightGateButtons);
+
+    wireLogic();
+
+    m_initialState = saveSnapshot();
+}
+
+void Simulation::restart() {
+    if (!m_board) return;
+    restoreSnapshot(m_initialState);
+}
+
+Simulation::Snapshot Simulation::saveSnapshot() const {
+    Snapshot snapshot;
+    snapshot.players.reserve(m_players.size());
+    for (const auto& player : m_players) snapshot.players.push_back(player.saveState());
+    snapshot.doors.reserve(m_doors.size());
+    for (const auto& door : m_doors) snapshot.doors.push_back(door.saveState());
+    snapshot.gates.reserve(m_gates.size());
+    for (const auto& gate : m_gates) snapshot.gates.push_back(gate.saveState());
+    snapshot.logic = m_logic.saveState();
+    snapshot.gameState = m_gameState;
+    return snapshot;
+}
+
+void Simulation::restoreSnapshot(const Snapshot& snapshot) {
+    for (std::size_t i = 0; i < m_players.size() && i < snapshot.players.size(); ++i) {
+        m_players[i].restoreState(snapshot.players[i]);
+    }
+    for (std::size_t i = 0; i < m_doors.size() && i < snapshot.doors.size(); ++i) {
+        m_doors[i].restoreState(snapshot.doors[i]);
+    }
+    for (std::size_t i = 0; i < m_gates.size() && i < snapshot.gates.size(); ++i) {
+        m_gates[i].restoreState(snapshot.gates[i]);
+    }
+    m_gameState = snapshot.gameState;
+    // Otherwise a restart after a win never logs the next one
+    m_winLogged = snapshot.gameState == GameState::Won;
+
+    // Resumable mid-level too: plates and door zones stay pressed, and
+    // doors whose player is at them keep rising
+    m_logic.restoreState(snapshot.logic, m_players);
+    m_raisingDoors.clear();
+    for (ActuatorId actuator = 0; actuator < m_actuatorTargets.size(); ++actuator) {
+        const ActuatorTarget& target = m_actuatorTargets[actuator];
+        if (target.door.isValid() && m_logic.isActive(actuator) && !m_doors[target.door.index].isOpen()) {
+            m_raisingDoors.push_back(target.door);
+        }
+    }
+}
+
+// Each gate is an OR of its plates; each door opens while its own player
+// stands in its zone
+void Simulation::wireLogic() {
+    for (std::uint32_t i = 0; i < m_gates.size(); ++i) {
+        ActuatorId gate = m_logic.addActuator(LogicOp::Or);
+        m_actuatorTargets.push_back(ActuatorTarget{GateHandle{i}, DoorHandle()});
+
+        for (const auto& plate : m_gates[i].getPlateRects()) {
+            m_logic.connect(m_logic.addTrigger(plate), gate);
+        }
+    }
+
+    for (std::uint32_t i = 0; i < m_doors.size(); ++i) {
+        ActuatorId door = m_logic.addActuator(LogicOp::Or);
+        m_actuatorTargets.push_back(ActuatorTarget{GateHandle(), DoorHandle{i}});
+
+        std::uint8_t opener = LogicNetwork::kindMask(m_doors[i].getOpener());
+        m_logic.connect(m_logic.addTrigger(m_doors[i].getTriggerZone(), opener), door);
+    }
+}
+
+void Simulation::applyActuator(ActuatorId actuator) {
+    const ActuatorTarget& target = m_actuatorTargets[actuator];
+    bool active = m_logic.isActive(actuator);
+
+    if (target.gate.isValid()) {
+        m_gates[target.gate.index].setPressed(active);
+        return;
+    }
+
+    m_doors[target.door.index].setPlayerAtDoor(active);
+    auto raising = std::find(m_raisingDoors.begin(), m_raisingDoors.end(), target.door);
+    if (active && raising == m_raisingDoors.end()) {
+        m_raisingDoors.push_back(target.door);
+    } else if (!active && raising != m_raisingDoors.end()) {
+        m_raisingDoors.erase(raising);
+    }
+}
+
+PlayerHandle Simulation::addPlayer(CharacterKind kind, const sf::Vector2f& position) {
+    PlayerHandle handle;
+    handle.index = static_cast<std::uint32_t>(m_players.size());
+    m_players.emplace_back(kind, position);
+    return handle;
+}
+
+DoorHandle Simulation::addDoor(DoorKind kind, const sf::Vector2f& position) {
+    DoorHandle handle;
+    handle.index = static_cast<std::uint32_t>(m_doors.size());
+    m_doors.emplace_back(kind, position);
+    return handle;
+}
+
+GateHandle Simulation::addGate(const sf::Vector2f& position, const std::vector<sf::Vector2f>& plates) {
+    GateHandle handle;
+    handle.index = static_cast<std::uint32_t>(m_gates.size());
+    m_gates.emplace_back(position, plates);
+    return handle;
+}
+
+void Simulation::update() {
+    if (m_gameState != GameState::Playing) return;
+
+    // Snapshot positions so the renderer can interpolate into this tick
+    for (auto& player : m_players) {
+        player.storePreviousPosition();
+    }
+    for (auto& door : m_doors) {
+        door.storePreviousPosition();
+    }
+
+    {
+        PROFILE_PHASE(Phase::Movement);
+
+        // Closed gates are solid like walls; players sweep against both
+        m_obstacles.clear();
+        for (const auto& gate : m_gates) {
+            if (!gate.isOpen()) m_obstacles.push_back(gate.getGateRect());
+        }
+
+        for (auto& player : m_players) {
+            if (!player.isDead()) {
+                player.update(*m_board, m_obstacles);
+            }
+        }
+    }
+
+    checkDeath();
+
+    {
+        PROFILE_PHASE(Phase::DoorsGates);
+
+        // Only plates/zones a player moved into or out of report changes
+        m_logic.update(m_players);
+        for (ActuatorId actuator : m_logic.getChangedActuators()) {
+            applyActuator(actuator);
+        }
+
+        for (DoorHandle door : m_raisingDoors) {
+            m_doors[door.index].tryRaiseDoor();
+        }
+        // Open doors stay open
+        m_raisingDoors.erase(std::remove_if(m_raisingDoors.begin(), m_raisingDoors.end(),
+                                            [this](DoorHandle door) { return m_doors[door.index].isOpen(); }),
+                             m_raisingDoors.end());
+    }
+
+    if (checkWin()) {
+        m_gameState = GameState::Won;
+    }
+
+    const Character* hot = getHotPlayer();
+    const Character* cold = getColdPlayer();
+    bool hotDead = (hot == nullptr || hot->isDead());
+    bool coldDead = (cold == nullptr || cold->isDead());
+
+    if (hotDead && coldDead && m_gameState == GameState::Playing) {
+        m_gameState = GameState::Lost;
+    }
+}
+
+void Simulation::checkDeath() {
+    PROFILE_PHASE(Phase::Death);
+
+    for (auto& player : m_players) {
+        if (player.isDead()) continue;
+
+        // Only the cells under the player are looked at, however many pools
+        std::uint8_t lethal = m_board->hazardsOverlapping(player.getRect()) & player.getLethalHazards();
+        if (!lethal) continue;
+
+        player.kill();
+        if (lethal & TILE_LAVA) {
+            LOG_INFO(LogCategory::Physics, "💀 COLD died in LAVA!");
+        } else if (lethal & TILE_WATER) {
+            LOG_INFO(LogCategory::Physics, "💀 HOT died in WATER!");
+        } else {
+            LOG_INFO(LogCategory::Physics, "DEAD_EMOJI " << player.getType() << " died in GOO!");
+        }
+    }
+}
+
+bool Simulation::checkWin() {
+    bool hotAtFireDoor = false;
+    bool coldAtWaterDoor = false;
+
+    const Character* hot = getHotPlayer();
+    const Character* cold = getColdPlayer();
+    if (!hot || hot->isDead()) return false;
+    if (!cold || cold->isDead()) return false;
+
+    for (const auto& door : m_doors) {
+        if (!door.isOpen()) continue;
+
+        sf::FloatRect doorRect = door.getRect();
+
+        if (door.getKind() == DoorKind::Fire && hot->getRect().findIntersection(doorRect)) {
+            hotAtFireDoor = true;
+        }
+
+        if (door.getKind() == DoorKind::Water && cold->getRect().findIntersection(doorRect)) {
+            coldAtWaterDoor = true;
+        }
+    }
+
+    bool currentWinState = (hotAtFireDoor && coldAtWaterDoor);
+
+    // Only log when state changes
+    if (currentWinState && !m_winLogged) {
+        LOG_INFO(LogCategory::Level, "[WIN] ★★★ WIN CONDITION MET! ★★★");
+    }
+
+    m_winLogged = currentWinState;
+    return currentWinState;
+}
+
+GameState Simulation::getGameState() const { return m_gameState; }
+int Simulation::getCurrentLevel() const { return m_currentLevel; }
+
+LogicNetwork& Simulation::getLogic() { return m_logic; }
+
+Board& Simulation::getBoard() { return *m_board; }
+const Board& Simulation::getBoard() const { return *m_board; }
+std::vector<Character>& Simulation::getPlayers() { return m_players; }
+const std::vector<Character>& Simulation::getPlayers() const { return m_players; }
+std::vector<Doors>& Simulation::getDoors() { return m_doors; }
+const std::vector<Doors>& Simulation::getDoors() const { return m_doors; }
+std::vector<Gates>& Simulation::getGates() { return m_gates; }
+const std::vector<Gates>& Simulation::getGates() const { return m_gates; }
+
+Character* Simulation::getPlayer(PlayerHandle handle) {
+    return handle.index < m_players.size() ? &m_players[handle.index] : nullptr;
+}
+
+const Character* Simulation::getPlayer(PlayerHandle handle) const {
+    return handle.index < m_players.size() ? &m_players[handle.index] : nullptr;
+}
+
+Doors* Simulation::getDoor(DoorHandle handle) {
+    return handle.index < m_doors.size() ? &m_doors[handle.index] : nullptr;
+}
+
+const Doors* Simulation::getDoor(DoorHandle handle) const {
+    return handle.index < m_doors.size() ? &m_doors[handle.index] : nullptr;
+}
+
+Gates* Simulation::getGate(GateHandle handle) {
+    return handle.index < m_gates.size() ? &m_gates[handle.index] : nullptr;
+}
+
+const Gates* Simulation::getGate(GateHandle handle) const {
+    return handle.index < m_gates.size() ? &m_gates[handle.index] : nullptr;
+}
+
+Character* Simulation::getHotPlayer() { return getPlayer(m_hotPlayer); }
+const Character* Simulation::getHotPlayer() const { return getPlayer(m_hotPlayer); }
+Character* Simulation::getColdPlayer() { return getPlayer(m_coldPlayer); }
+const Character* Simulation::getColdPlayer() const { return getPlayer(m_coldPlayer); }
+
+void Simulation::cleanup() {
+    m_players.clear();
+    m_doors.clear();
+    m_gates.clear();
+
+    m_hotPlayer = PlayerHandle();
+    m_coldPlayer = PlayerHandle();
+
+    m_logic.clear();
+    m_actuatorTargets.clear();
+    m_raisingDoors.clear();
+}
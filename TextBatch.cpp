@@ -0,0 +1,144 @@
+#include "include/TextBatch.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+// Glyphs are stored with a pixel of padding in the font texture; sf::Text
+// draws that pixel too so antialiased edges aren't clipped
+constexpr float GLYPH_PADDING = 1.0f;
+
+void appendGlyph(sf::VertexArray& vertices, const sf::Vector2f& origin, const sf::Glyph& glyph, sf::Color color) {
+    const float left = origin.x + glyph.bounds.position.x - GLYPH_PADDING;
+    const float top = origin.y + glyph.bounds.position.y - GLYPH_PADDING;
+    const float right = origin.x + glyph.bounds.position.x + glyph.bounds.size.x + GLYPH_PADDING;
+    const float bottom = origin.y + glyph.bounds.position.y + glyph.bounds.size.y + GLYPH_PADDING;
+
+    const float u1 = static_cast<float>(glyph.textureRect.position.x) - GLYPH_PADDING;
+    const float v1 = static_cast<float>(glyph.textureRect.position.y) - GLYPH_PADDING;
+    const float u2 = static_cast<float>(glyph.textureRect.position.x + glyph.textureRect.size.x) + GLYPH_PADDING;
+    const float v2 = static_cast<float>(glyph.textureRect.position.y + glyph.textureRect.size.y) + GLYPH_PADDING;
+
+    vertices.append(sf::Vertex{sf::Vector2f(left, top), color, sf::Vector2f(u1, v1)});
+    vertices.append(sf::Vertex{sf::Vector2f(right, top), color, sf::Vector2f(u2, v1)});
+    vertices.append(sf::Vertex{sf::Vector2f(left, bottom), color, sf::Vector2f(u1, v2)});
+
+    vertices.append(sf::Vertex{sf::Vector2f(left, bottom), color, sf::Vector2f(u1, v2)});
+    vertices.append(sf::Vertex{sf::Vector2f(right, top), color, sf::Vector2f(u2, v1)});
+    vertices.append(sf::Vertex{sf::Vector2f(right, bottom), color, sf::Vector2f(u2, v2)});
+}
+
+}
+
+TextBatch::TextBatch(const sf::Font& font)
+    : m_font(font),
+      m_dirty(true)
+{
+}
+
+TextBatch::LabelId TextBatch::add(const std::string& text, const sf::Vector2f& position, unsigned int size,
+                                  sf::Color color, bool bold, Align align) {
+    m_labels.push_back(Label{text, position, size, color, bold, align});
+    m_dirty = true;
+    return m_labels.size() - 1;
+}
+
+void TextBatch::setText(LabelId label, const std::string& text) {
+    if (m_labels[label].text == text) return;
+    m_labels[label].text = text;
+    m_dirty = true;
+}
+
+void TextBatch::setPosition(LabelId label, const sf::Vector2f& position) {
+    if (m_labels[label].position == position) return;
+    m_labels[label].position = position;
+    m_dirty = true;
+}
+
+void TextBatch::setColor(LabelId label, sf::Color color) {
+    if (m_labels[label].color == color) return;
+    m_labels[label].color = color;
+    m_dirty = true;
+}
+
+void TextBatch::setBold(LabelId label, bool bold) {
+    if (m_labels[label].bold == bold) return;
+    m_labels[label].bold = bold;
+    m_dirty = true;
+}
+
+std::size_t TextBatch::getDrawCallCount() const {
+    if (m_dirty) rebuild();
+    return m_layers.size();
+}
+
+void TextBatch::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    if (m_dirty) rebuild();
+
+    for (const auto& layer : m_layers) {
+        // Looked up per draw: loading new glyphs may have resized the texture
+        states.texture = &m_font.getTexture(layer.size);
+        target.draw(layer.vertices, states);
+    }
+}
+
+void TextBatch::rebuild() const {
+    for (auto& layer : m_layers) layer.vertices.clear();
+
+    for (const auto& label : m_labels) {
+        auto layer = std::find_if(m_layers.begin(), m_layers.end(),
+                                  [&](const Layer& existing) { return existing.size == label.size; });
+        if (layer == m_layers.end()) {
+            m_layers.push_back(Layer{label.size, sf::VertexArray(sf::PrimitiveType::Triangles)});
+            layer = m_layers.end() - 1;
+        }
+        appendLabel(label, layer->vertices);
+    }
+
+    // Sizes nobody uses any more
+    m_layers.erase(std::remove_if(m_layers.begin(), m_layers.end(),
+                                  [](const Layer& layer) { return layer.vertices.getVertexCount() == 0; }),
+                   m_layers.end());
+    m_dirty = false;
+}
+
+// Same layout as sf::Text: baseline one character size below the top,
+// kerning between neighbours, whitespace only advances
+void TextBatch::appendLabel(const Label& label, sf::VertexArray& vertices) const {
+    const std::size_t first = vertices.getVertexCount();
+    const float lineSpacing = m_font.getLineSpacing(label.size);
+
+    sf::Vector2f pen(0.0f, static_cast<float>(label.size));
+    float minX = std::numeric_limits<float>::max();
+    float maxX = std::numeric_limits<float>::lowest();
+    std::uint32_t previous = 0;
+
+    for (char32_t codePoint : sf::String::fromUtf8(label.text.begin(), label.text.end())) {
+        if (codePoint == U'\r') continue;
+
+        pen.x += m_font.getKerning(previous, codePoint, label.size, label.bold);
+        previous = codePoint;
+
+        if (codePoint == U'\n') {
+            pen = sf::Vector2f(0.0f, pen.y + lineSpacing);
+            continue;
+        }
+
+        const sf::Glyph& glyph = m_font.getGlyph(codePoint, label.size, label.bold);
+        if (codePoint != U' ' && codePoint != U'\t') {
+            appendGlyph(vertices, pen, glyph, label.color);
+            minX = std::min(minX, pen.x + glyph.bounds.position.x);
+            maxX = std::max(maxX, pen.x + glyph.bounds.position.x + glyph.bounds.size.x);
+        }
+        pen.x += glyph.advance;
+    }
+
+    if (vertices.getVertexCount() == first) return;
+
+    sf::Vector2f offset = label.position;
+    if (label.align == Align::Center) offset.x -= (maxX - minX) / 2.0f;
+
+    for (std::size_t i = first; i < vertices.getVertexCount(); ++i) {
+        vertices[i].position += offset;
+    }
+}
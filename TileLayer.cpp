@@ -0,0 +1,104 @@
+#include "include/TileLayer.h"
+#include <algorithm>
+#include <cmath>
+
+TileLayer::TileLayer()
+    : m_board(nullptr),
+      m_atlas(nullptr),
+      m_vertices(sf::PrimitiveType::Triangles),
+      m_range{0, 0, 0, 0},
+      m_tileCount(0)
+{
+}
+
+void TileLayer::build(const Board& board) {
+    m_vertices.clear();
+    m_range = CellRange{0, 0, 0, 0};
+    m_tileCount = 0;
+    m_board = nullptr;
+    m_atlas = nullptr;
+
+    const TileAtlas* atlas = board.getTileAtlas();
+    if (!atlas) return;
+    m_board = &board;
+    m_atlas = &atlas->texture;
+
+    // Blank cell sampled at its centre so flat-coloured tiles don't bleed
+    sf::IntRect blank = atlas->blankRect;
+    sf::IntRect blankCentre(blank.position + blank.size / 2, sf::Vector2i(0, 0));
+
+    for (std::size_t id = 0; id < Tiles::COUNT; ++id) {
+        if (atlas->rects[id].size.x > 0) {
+            m_texRects[id] = atlas->rects[id];
+            m_colors[id] = sf::Color::White;
+        } else {
+            std::uint32_t rgb = Tiles::PROPERTIES[id].fallbackColor;
+            m_texRects[id] = blankCentre;
+            m_colors[id] = sf::Color(static_cast<std::uint8_t>(rgb >> 16),
+                                     static_cast<std::uint8_t>(rgb >> 8),
+                                     static_cast<std::uint8_t>(rgb));
+        }
+    }
+}
+
+void TileLayer::cull(const sf::FloatRect& visibleArea) {
+    if (!m_board) return;
+
+    const float chunk = static_cast<float>(Board::CHUNK_SIZE);
+
+    CellRange range;
+    range.firstColumn = std::max(0, static_cast<int>(std::floor(visibleArea.position.x / chunk)));
+    range.firstRow = std::max(0, static_cast<int>(std::floor(visibleArea.position.y / chunk)));
+    range.lastColumn = std::min(m_board->getGridColumns(),
+        static_cast<int>(std::ceil((visibleArea.position.x + visibleArea.size.x) / chunk)));
+    range.lastRow = std::min(m_board->getGridRows(),
+        static_cast<int>(std::ceil((visibleArea.position.y + visibleArea.size.y) / chunk)));
+
+    if (range == m_range) return;
+    m_range = range;
+
+    m_vertices.clear();
+    m_tileCount = 0;
+
+    for (int y = range.firstRow; y < range.lastRow; ++y) {
+        for (int x = range.firstColumn; x < range.lastColumn; ++x) {
+            TileId tile = m_board->getTile(x, y);
+            if (tile == Tiles::EMPTY) continue;
+
+            sf::FloatRect rect(sf::Vector2f(x * chunk, y * chunk), sf::Vector2f(chunk, chunk));
+            TileId id = tile < Tiles::COUNT ? tile : Tiles::UNKNOWN;
+            appendTile(rect, m_texRects[id], m_colors[id]);
+            ++m_tileCount;
+        }
+    }
+}
+
+std::size_t TileLayer::getTileCount() const {
+    return m_tileCount;
+}
+
+void TileLayer::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    states.texture = m_atlas;
+    target.draw(m_vertices, states);
+}
+
+// Two triangles per tile
+void TileLayer::appendTile(const sf::FloatRect& rect, const sf::IntRect& texRect, sf::Color color) {
+    const sf::Vector2f topLeft = rect.position;
+    const sf::Vector2f topRight(rect.position.x + rect.size.x, rect.position.y);
+    const sf::Vector2f bottomLeft(rect.position.x, rect.position.y + rect.size.y);
+    const sf::Vector2f bottomRight = rect.position + rect.size;
+
+    const sf::Vector2f texTopLeft(texRect.position);
+    const sf::Vector2f texTopRight(static_cast<float>(texRect.position.x + texRect.size.x), static_cast<float>(texRect.position.y));
+    const sf::Vector2f texBottomLeft(static_cast<float>(texRect.position.x), static_cast<float>(texRect.position.y + texRect.size.y));
+    const sf::Vector2f texBottomRight(texRect.position + texRect.size);
+
+    m_vertices.append(sf::Vertex{topLeft, color, texTopLeft});
+    m_vertices.append(sf::Vertex{topRight, color, texTopRight});
+    m_vertices.append(sf::Vertex{bottomLeft, color, texBottomLeft});
+
+    m_vertices.append(sf::Vertex{bottomLeft, color, texBottomLeft});
+    m_vertices.append(sf::Vertex{topRight, color, texTopRight});
+    m_vertices.append(sf::Vertex{bottomRight, color, texBottomRight});
+}
@@ -1,96 +1,484 @@
-// Compile: g++ analyze_level.cpp -o analyze.exe -std=c++17
+// Build: the analyze_level target (or "make analyze")
 // Run: ./analyze.exe data/level1.txt
+//      ./analyze.exe --solve data/level1.txt [--threads N] [--max-states N] [--witness out.hcr]
+//      ./analyze.exe --batch <dir | "dir/level*.txt"> [--threads N] [--csv] [--report out.json]
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
 #include <iostream>
 #include <fstream>
-#include <sstream>
+#include <thread>
 #include <vector>
 #include <map>
 #include <string>
+#include "include/Tiles.h"
+#include "include/Controller.h"
+#include "include/LevelCheck.h"
+#include "include/LevelSolver.h"
+#include "include/Log.h"
+#include "include/Replay.h"
+#include "include/Simulation.h"
 
-int main(int argc, char* argv[]) {
-    std::string filename = (argc > 1) ? argv[1] : "data/level1.txt";
+namespace {
 
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open: " << filename << std::endl;
-        return 1;
-    }
+std::string describeInputs(std::uint8_t inputs, std::uint8_t right, std::uint8_t left, std::uint8_t jump) {
+    std::string text;
+    if (inputs & left)  text += " left";
+    if (inputs & right) text += " right";
+    if (inputs & jump)  text += " jump";
+    return text.empty() ? " -" : text;
+}
+
+// Replays refer to levels by number: "data/level3.txt" -> 3, else 0
+int levelNumberOf(const std::string& filename) {
+    std::size_t name = filename.find_last_of("/\\");
+    name = (name == std::string::npos) ? 0 : name + 1;
+    if (filename.compare(name, 5, "level") != 0) return 0;
 
-    std::vector<std::vector<std::string>> gameMap;
-    std::map<std::string, int> tileCounts;
+    int number = 0;
+    for (std::size_t i = name + 5; i < filename.size() && std::isdigit(static_cast<unsigned char>(filename[i])); ++i) {
+        number = number * 10 + (filename[i] - '0');
+    }
+    return number;
+}
 
-    std::string line;
-    while (std::getline(file, line)) {
-        std::vector<std::string> row;
-        std::stringstream ss(line);
-        std::string tile;
+// Plays the witness as key presses through Controller, the way Game does,
+// so it only passes if a player could actually key it in: each key is
+// pressed when its input comes on and held until it goes off, never
+// pressed again every tick. True if that wins and every tick samples
+// exactly the witness's inputs, which a held jump (jumping again, or
+// higher) would not.
+bool playsThroughController(const std::string& filename, const std::vector<std::uint8_t>& witness) {
+    Simulation simulation;
+    simulation.loadLevel(filename);
+    Controller controller;
 
-        while (std::getline(ss, tile, ',')) {
-            row.push_back(tile);
-            tileCounts[tile]++;
+    auto keyFor = [&controller](std::size_t action) {
+        return controller.getBindings(static_cast<Controller::Action>(action)).front().key;
+    };
+    const std::uint8_t bits[] = {Replay::HOT_RIGHT, Replay::HOT_LEFT, Replay::HOT_JUMP,
+                                 Replay::COLD_RIGHT, Replay::COLD_LEFT, Replay::COLD_JUMP};
+    std::uint8_t down = 0;
+    for (std::uint8_t inputs : witness) {
+        for (std::size_t action = 0; action < Controller::ACTION_COUNT; ++action) {
+            const std::uint8_t bit = bits[action];
+            if ((inputs & bit) && !(down & bit)) {
+                controller.handleEvent(sf::Event::KeyPressed{keyFor(action)});
+            } else if (!(inputs & bit) && (down & bit)) {
+                controller.handleEvent(sf::Event::KeyReleased{keyFor(action)});
+            }
         }
+        down = inputs;
 
-        gameMap.push_back(row);
+        const std::uint8_t sampled = controller.sample(Replay::pendingJumps(simulation));
+        if (sampled != inputs) return false;
+        Replay::applyInputs(simulation, sampled);
+        simulation.update();
     }
-    file.close();
+    return simulation.getGameState() == GameState::Won;
+}
 
-    std::cout << "=== LEVEL ANALYSIS ===" << std::endl;
+// Search for a way through; exit code 0 if there is one, 2 if not
+int runSolver(const std::string& filename, const LevelSolver::Options& options, const std::string& witnessPath) {
+    // Every worker loads the level and players die by the thousand
+    Logger::instance().setMinimumLevel(LogLevel::Warning);
+
+    std::cout << "=== SOLVER ===" << std::endl;
     std::cout << "File: " << filename << std::endl;
-    std::cout << "Rows: " << gameMap.size() << std::endl;
-    if (!gameMap.empty()) {
-        std::cout << "Columns: " << gameMap[0].size() << std::endl;
+
+    LevelSolver::Result result = LevelSolver::solve(filename, options);
+
+    std::cout << "Threads: " << result.threads << std::endl;
+    std::cout << "States: " << result.statesExplored << " (" << result.duplicates << " duplicates skipped)" << std::endl;
+    std::cout << "Time: " << result.seconds << " s" << std::endl;
+
+    if (result.verdict != LevelSolver::Verdict::Solved) {
+        Logger::instance().flush();
+        const std::string stage = result.stuckPlayer.empty() ? "both players" : "the " + result.stuckPlayer + " player alone";
+        if (result.verdict == LevelSolver::Verdict::GaveUp) {
+            std::cout << "Result: UNKNOWN - gave up after " << options.maxStates << " states moving " << stage << std::endl;
+        } else if (!result.stuckPlayer.empty()) {
+            std::cout << "Result: NO SOLUTION - the " << result.stuckPlayer
+                      << " player can't reach its door even with every gate open" << std::endl;
+        } else {
+            std::cout << "Result: NO SOLUTION found (within " << options.maxTicks << " ticks)" << std::endl;
+        }
+        return 2;
     }
-    std::cout << std::endl;
 
-    std::cout << "Tile Type Counts:" << std::endl;
-    for (const auto& pair : tileCounts) {
-        std::string type = pair.first;
-        int count = pair.second;
+    // Play the witness from scratch, exactly as a replay would
+    Simulation simulation;
+    simulation.loadLevel(filename);
+    Replay replay;
+    replay.begin(levelNumberOf(filename));
+    for (std::uint8_t inputs : result.witness) {
+        replay.recordTick(inputs);
+        Replay::applyInputs(simulation, inputs);
+        simulation.update();
+    }
+    replay.finish(simulation);
+    Logger::instance().flush();
 
-        std::string description;
-        if (type == "0") description = "Empty space";
-        else if (type == "2") description = "LAVA (kills cold)";
-        else if (type == "3") description = "WATER (kills hot)";
-        else if (type == "4") description = "GOO (kills both)";
-        else if (type == "100") description = "Wall type 1";
-        else if (type == "111") description = "Wall type 2";
-        else description = "Wall/Platform";
+    const bool replayed = simulation.getGameState() == GameState::Won;
+    const bool playable = replayed && playsThroughController(filename, result.witness);
+    const bool verified = replayed && playable;
+    Logger::instance().flush();
+    std::cout << "Result: SOLVABLE in " << result.witness.size() << " ticks ("
+              << result.witness.size() / static_cast<double>(Simulation::TICKS_PER_SECOND) << " s)"
+              << (!replayed ? ", WITNESS DID NOT REPLAY"
+                  : !playable ? ", WITNESS NOT PLAYABLE WITH THE KEYS" : ", witness verified") << std::endl;
 
-        std::cout << "  " << type << ": " << count << " (" << description << ")" << std::endl;
+    std::cout << "Witness (hot | cold):" << std::endl;
+    std::uint32_t tick = 0;
+    for (const auto& run : replay.getRuns()) {
+        std::cout << "  tick " << tick << " +" << run.ticks << ":"
+                  << describeInputs(run.inputs, Replay::HOT_RIGHT, Replay::HOT_LEFT, Replay::HOT_JUMP) << " |"
+                  << describeInputs(run.inputs, Replay::COLD_RIGHT, Replay::COLD_LEFT, Replay::COLD_JUMP) << std::endl;
+        tick += run.ticks;
     }
-    std::cout << std::endl;
 
-    // Analyze spawn safety at common spawn locations
-    std::cout << "Spawn Safety Analysis:" << std::endl;
+    if (!witnessPath.empty()) {
+        if (replay.getLevel() == 0) {
+            std::cout << "Witness not saved: replays need a data/level<N>.txt level" << std::endl;
+        } else if (replay.saveToFile(witnessPath)) {
+            std::cout << "Witness saved to " << witnessPath << " (hot_and_cold_headless --replay)" << std::endl;
+        }
+    }
+    Logger::instance().flush();
+    return verified ? 0 : 2;
+}
 
-    // Check position (32, 416) - pixel coords
-    int row_416 = 416 / 16;  // = 26
-    int col_32 = 32 / 16;    // = 2
+// Codes LevelCheck counted as unknown, by name; only looked up for a report
+std::map<std::string, int> unknownCodes(std::string_view text) {
+    std::map<std::string, int> codes;
+    std::size_t start = 0;
+    for (std::size_t i = 0; i <= text.size(); ++i) {
+        if (i < text.size() && text[i] != ',' && text[i] != '\n' && text[i] != '\r') continue;
+        std::string_view code = text.substr(start, i - start);
+        if (!code.empty() && Tiles::parseTileCode(code) == Tiles::UNKNOWN) codes[std::string(code)]++;
+        start = i + 1;
+    }
+    return codes;
+}
 
-    if (row_416 < gameMap.size() && col_32 < gameMap[row_416].size()) {
-        std::string tile = gameMap[row_416][col_32];
-        std::cout << "  Position (32, 416) = Row " << row_416 << ", Col " << col_32
-                  << ": Tile '" << tile << "'";
-        if (tile == "2" || tile == "3" || tile == "4") {
-            std::cout << " ❌ HAZARD - UNSAFE!" << std::endl;
-        } else if (tile == "0") {
-            std::cout << " ✓ Empty - SAFE" << std::endl;
+std::string describeIssue(LevelCheck::Issue issue, const LevelCheck::Result& check) {
+    using LevelCheck::Issue;
+    switch (issue) {
+        case Issue::Empty:
+            return "Level has no rows";
+        case Issue::TooSmall:
+            return "Level should be at least " + std::to_string(LevelCheck::MIN_COLUMNS) + "x" +
+                   std::to_string(LevelCheck::MIN_ROWS) + " tiles, is " + std::to_string(check.columns) + "x" +
+                   std::to_string(check.rows);
+        case Issue::SpawnBlocked:
+            return "A spawn point is in a wall, a hazard or off the map";
+        case Issue::RaggedRows:
+            return std::to_string(check.raggedRows) + " rows are not as wide as the first (padded with empty space)";
+        case Issue::UnknownCodes:
+            return std::to_string(check.tileCounts[Tiles::UNKNOWN]) + " unknown tile codes (treated as walls)";
+        case Issue::NoHazards:
+            return "No hazards found - game will be too easy!";
+        default:
+            return "?";
+    }
+}
+
+// `pattern` is a directory (every .txt in it), a file, or a path whose
+// last part has * and ? wildcards, e.g. "levels/user_*.txt"
+bool matchesWildcard(std::string_view pattern, std::string_view name) {
+    if (pattern.empty()) return name.empty();
+    if (pattern[0] == '*') {
+        for (std::size_t skip = 0; skip <= name.size(); ++skip) {
+            if (matchesWildcard(pattern.substr(1), name.substr(skip))) return true;
+        }
+        return false;
+    }
+    if (name.empty() || (pattern[0] != '?' && pattern[0] != name[0])) return false;
+    return matchesWildcard(pattern.substr(1), name.substr(1));
+}
+
+std::vector<std::string> collectLevelFiles(const std::string& pattern) {
+    namespace fs = std::filesystem;
+    std::vector<std::string> files;
+    std::error_code error;
+
+    fs::path path(pattern);
+    std::string wildcard = path.filename().string();
+    fs::path directory = path.parent_path().empty() ? fs::path(".") : path.parent_path();
+    if (fs::is_directory(path, error)) {
+        directory = path;
+        wildcard = "*.txt";
+    } else if (wildcard.find_first_of("*?") == std::string::npos) {
+        if (fs::is_regular_file(path, error)) files.push_back(pattern);
+        return files;
+    }
+
+    for (fs::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        if (it->is_regular_file(error) && matchesWildcard(wildcard, it->path().filename().string())) {
+            files.push_back(it->path().string());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+struct FileReport {
+    std::string path;
+    bool readable = false;
+    std::size_t bytes = 0;
+    LevelCheck::Result check;
+    double readMicros = 0.0;
+    double checkMicros = 0.0;
+};
+
+const char* statusOf(const FileReport& report) {
+    if (!report.readable) return "unreadable";
+    return report.check.passed() ? "pass" : "fail";
+}
+
+std::string jsonString(const std::string& text) {
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+            quoted += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            const char* hex = "0123456789abcdef";
+            quoted += "\\u00";
+            quoted += hex[(c >> 4) & 0xF];
+            quoted += hex[c & 0xF];
         } else {
-            std::cout << " ⚠️ Solid block - will spawn inside wall!" << std::endl;
+            quoted += c;
+        }
+    }
+    return quoted + "\"";
+}
+
+std::string csvField(const std::string& text) {
+    if (text.find_first_of(",\"\n") == std::string::npos) return text;
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+std::vector<const char*> issueNames(const LevelCheck::Result& check) {
+    std::vector<const char*> names;
+    for (unsigned i = 0; i < static_cast<unsigned>(LevelCheck::Issue::COUNT); ++i) {
+        auto issue = static_cast<LevelCheck::Issue>(i);
+        if (check.has(issue)) names.push_back(LevelCheck::issueName(issue));
+    }
+    return names;
+}
+
+void writeJson(std::ostream& out, const std::vector<FileReport>& reports, unsigned int threads,
+               double wallMillis, std::size_t failed) {
+    out << "{\n";
+    out << "  \"files\": " << reports.size() << ",\n";
+    out << "  \"failed\": " << failed << ",\n";
+    out << "  \"threads\": " << threads << ",\n";
+    out << "  \"wall_ms\": " << wallMillis << ",\n";
+    out << "  \"levels\": [";
+    for (std::size_t i = 0; i < reports.size(); ++i) {
+        const FileReport& report = reports[i];
+        const LevelCheck::Result& check = report.check;
+        out << (i ? ",\n    " : "\n    ");
+        out << "{\"file\": " << jsonString(report.path) << ", \"status\": \"" << statusOf(report) << "\""
+            << ", \"bytes\": " << report.bytes << ", \"rows\": " << check.rows << ", \"columns\": " << check.columns
+            << ", \"lava\": " << check.tileCounts[Tiles::LAVA] << ", \"water\": " << check.tileCounts[Tiles::WATER]
+            << ", \"goo\": " << check.tileCounts[Tiles::GOO] << ", \"unknown\": " << check.tileCounts[Tiles::UNKNOWN]
+            << ", \"issues\": [";
+        std::vector<const char*> names = issueNames(check);
+        for (std::size_t n = 0; n < names.size(); ++n) out << (n ? ", \"" : "\"") << names[n] << "\"";
+        out << "], \"read_us\": " << report.readMicros << ", \"check_us\": " << report.checkMicros << "}";
+    }
+    out << "\n  ]\n}" << std::endl;
+}
+
+void writeCsv(std::ostream& out, const std::vector<FileReport>& reports) {
+    out << "file,status,bytes,rows,columns,lava,water,goo,unknown,issues,read_us,check_us" << std::endl;
+    for (const FileReport& report : reports) {
+        const LevelCheck::Result& check = report.check;
+        out << csvField(report.path) << ',' << statusOf(report) << ',' << report.bytes << ',' << check.rows << ','
+            << check.columns << ',' << check.tileCounts[Tiles::LAVA] << ',' << check.tileCounts[Tiles::WATER] << ','
+            << check.tileCounts[Tiles::GOO] << ',' << check.tileCounts[Tiles::UNKNOWN] << ',';
+        std::vector<const char*> names = issueNames(check);
+        for (std::size_t n = 0; n < names.size(); ++n) out << (n ? ";" : "") << names[n];
+        out << ',' << report.readMicros << ',' << report.checkMicros << '\n';
+    }
+    out.flush();
+}
+
+// Check every level `pattern` matches on a pool of threads and write one
+// report; exit code 0 if they all pass, 2 if any fails
+int runBatch(const std::string& pattern, unsigned int threads, const std::string& reportPath, bool csv) {
+    using Clock = std::chrono::steady_clock;
+    auto micros = [](Clock::duration duration) { return std::chrono::duration<double, std::micro>(duration).count(); };
+
+    std::vector<FileReport> reports;
+    for (std::string& path : collectLevelFiles(pattern)) {
+        reports.emplace_back();
+        reports.back().path = std::move(path);
+    }
+    if (reports.empty()) {
+        std::cerr << "No level files match: " << pattern << std::endl;
+        return 1;
+    }
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned int>(std::min<std::size_t>(threads, reports.size()));
+
+    // Workers take the next file in turn, each into its own buffer, so once
+    // that has grown to the largest file nothing more is allocated
+    std::atomic<std::size_t> nextFile(0);
+    auto work = [&] {
+        std::vector<char> buffer;
+        for (std::size_t i = nextFile++; i < reports.size(); i = nextFile++) {
+            FileReport& report = reports[i];
+            auto start = Clock::now();
+            report.readable = LevelCheck::readFile(report.path, buffer);
+            auto read = Clock::now();
+            if (!report.readable) continue;
+
+            report.bytes = buffer.size();
+            report.check = LevelCheck::check(std::string_view(buffer.data(), buffer.size()));
+            report.readMicros = micros(read - start);
+            report.checkMicros = micros(Clock::now() - read);
         }
+    };
+
+    auto start = Clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned int i = 0; i < threads; ++i) workers.emplace_back(work);
+    for (auto& worker : workers) worker.join();
+    const double wallMillis = micros(Clock::now() - start) / 1000.0;
+
+    std::size_t failed = 0;
+    double readMicros = 0.0;
+    double checkMicros = 0.0;
+    for (const FileReport& report : reports) {
+        if (!report.readable || !report.check.passed()) ++failed;
+        readMicros += report.readMicros;
+        checkMicros += report.checkMicros;
     }
 
-    // Check position (580, 416)
-    int col_580 = 580 / 16;  // = 36
+    std::ofstream file;
+    if (!reportPath.empty()) {
+        file.open(reportPath);
+        if (!file.is_open()) {
+            std::cerr << "Failed to write: " << reportPath << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = reportPath.empty() ? std::cout : file;
+    out << std::fixed << std::setprecision(1);
+    if (csv) {
+        writeCsv(out, reports);
+    } else {
+        writeJson(out, reports, threads, wallMillis, failed);
+    }
+
+    // The report may be on stdout, so the summary goes to stderr
+    std::cerr << std::fixed << std::setprecision(1) << "Checked " << reports.size() << " levels in " << wallMillis
+              << " ms on " << threads << (threads == 1 ? " thread: " : " threads: ") << failed << " failed (reading " << readMicros / 1000.0
+              << " ms, checking " << checkMicros / 1000.0 << " ms in total)" << std::endl;
+    return failed ? 2 : 0;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    std::string filename = "data/level1.txt";
+    bool solve = false;
+    LevelSolver::Options solverOptions;
+    std::string witnessPath;
+    std::string batchPattern;
+    std::string reportPath;
+    bool csv = false;
 
-    if (row_416 < gameMap.size() && col_580 < gameMap[row_416].size()) {
-        std::string tile = gameMap[row_416][col_580];
-        std::cout << "  Position (580, 416) = Row " << row_416 << ", Col " << col_580
-                  << ": Tile '" << tile << "'";
-        if (tile == "2" || tile == "3" || tile == "4") {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--solve") {
+            solve = true;
+        } else if (arg == "--batch" && i + 1 < argc) {
+            batchPattern = argv[++i];
+        } else if (arg == "--report" && i + 1 < argc) {
+            reportPath = argv[++i];
+        } else if (arg == "--csv") {
+            csv = true;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            solverOptions.threads = static_cast<unsigned int>(std::stoul(argv[++i]));
+        } else if (arg == "--max-states" && i + 1 < argc) {
+            solverOptions.maxStates = std::stoull(argv[++i]);
+        } else if (arg == "--witness" && i + 1 < argc) {
+            witnessPath = argv[++i];
+        } else {
+            filename = arg;
+        }
+    }
+
+    if (solve) return runSolver(filename, solverOptions, witnessPath);
+    if (!batchPattern.empty()) return runBatch(batchPattern, solverOptions.threads, reportPath, csv);
+
+    std::vector<char> text;
+    if (!LevelCheck::readFile(filename, text)) {
+        std::cerr << "Failed to open: " << filename << std::endl;
+        return 1;
+    }
+
+    // Row-major tile IDs; rows are kept at their real width so the
+    // ragged-row check can be seen in the dump below
+    std::vector<TileId> tiles;
+    std::vector<size_t> rowStarts;
+    const LevelCheck::Result check = LevelCheck::check(std::string_view(text.data(), text.size()), &tiles, &rowStarts);
+
+    const size_t rows = rowStarts.size();
+    auto rowWidth = [&](size_t y) {
+        return ((y + 1 < rows) ? rowStarts[y + 1] : tiles.size()) - rowStarts[y];
+    };
+
+    std::cout << "=== LEVEL ANALYSIS ===" << std::endl;
+    std::cout << "File: " << filename << std::endl;
+    std::cout << "Rows: " << check.rows << std::endl;
+    std::cout << "Columns: " << check.columns << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "Tile Type Counts:" << std::endl;
+    for (size_t id = 0; id < Tiles::COUNT; ++id) {
+        if (check.tileCounts[id] == 0) continue;
+
+        const TileProperties& props = Tiles::PROPERTIES[id];
+        std::cout << "  " << props.code << ": " << check.tileCounts[id] << " (" << props.description << ")" << std::endl;
+    }
+    if (check.has(LevelCheck::Issue::UnknownCodes)) {
+        for (const auto& pair : unknownCodes(std::string_view(text.data(), text.size()))) {
+            std::cout << "    unknown code '" << pair.first << "' x" << pair.second << std::endl;
+        }
+    }
+    std::cout << std::endl;
+
+    // Analyze spawn safety at the spawn locations
+    std::cout << "Spawn Safety Analysis:" << std::endl;
+    for (size_t i = 0; i < LevelCheck::SPAWN_COUNT; ++i) {
+        const LevelCheck::Rect& spawn = LevelCheck::SPAWN_RECTS[i];
+        TileId tile = check.spawnTiles[i];
+        std::cout << "  Position (" << spawn.x << ", " << spawn.y << ") = Rows " << spawn.y / LevelCheck::TILE_SIZE
+                  << "-" << (spawn.y + spawn.height - 1) / LevelCheck::TILE_SIZE << ", Cols "
+                  << spawn.x / LevelCheck::TILE_SIZE << "-" << (spawn.x + spawn.width - 1) / LevelCheck::TILE_SIZE;
+        if (tile == LevelCheck::OUTSIDE) {
+            std::cout << ": reaches outside the map" << std::endl;
+            continue;
+        }
+        std::cout << ": Tile '" << Tiles::properties(tile).code << "'";
+        if (Tiles::properties(tile).flags & TILE_HAZARD) {
             std::cout << " ❌ HAZARD - UNSAFE!" << std::endl;
-        } else if (tile == "0") {
+        } else if (tile == Tiles::EMPTY) {
             std::cout << " ✓ Empty - SAFE" << std::endl;
         } else {
             std::cout << " ⚠️ Solid block - will spawn inside wall!" << std::endl;
@@ -103,16 +491,11 @@ int main(int argc, char* argv[]) {
     std::cout << "Legend: 0=empty, 2=LAVA, 3=WATER, 4=GOO, X=wall" << std::endl;
     std::cout << std::endl;
 
-    size_t startRow = (gameMap.size() > 6) ? gameMap.size() - 6 : 0;
-    for (size_t y = startRow; y < gameMap.size(); ++y) {
+    size_t startRow = (rows > 6) ? rows - 6 : 0;
+    for (size_t y = startRow; y < rows; ++y) {
         std::cout << "Row " << y << " (y=" << (y*16) << "): ";
-        for (size_t x = 0; x < gameMap[y].size() && x < 40; ++x) {
-            const std::string& tile = gameMap[y][x];
-            if (tile == "0") std::cout << ".";
-            else if (tile == "2") std::cout << "L";  // Lava
-            else if (tile == "3") std::cout << "W";  // Water
-            else if (tile == "4") std::cout << "G";  // Goo
-            else std::cout << "#";  // Wall
+        for (size_t x = 0; x < rowWidth(y) && x < 40; ++x) {
+            std::cout << Tiles::properties(tiles[rowStarts[y] + x]).symbol;
         }
         std::cout << std::endl;
     }
@@ -120,24 +503,11 @@ int main(int argc, char* argv[]) {
 
     // Check for common mistakes
     std::cout << "Potential Issues:" << std::endl;
-    bool issues = false;
-
-    if (gameMap.size() != 30) {
-        std::cout << "  ⚠️ Level should have 30 rows, has " << gameMap.size() << std::endl;
-        issues = true;
-    }
-
-    if (!gameMap.empty() && gameMap[0].size() != 40) {
-        std::cout << "  ⚠️ Level should have 40 columns, has " << gameMap[0].size() << std::endl;
-        issues = true;
+    for (unsigned i = 0; i < static_cast<unsigned>(LevelCheck::Issue::COUNT); ++i) {
+        auto issue = static_cast<LevelCheck::Issue>(i);
+        if (check.has(issue)) std::cout << "  ⚠️ " << describeIssue(issue, check) << std::endl;
     }
-
-    if (tileCounts["2"] == 0 && tileCounts["3"] == 0) {
-        std::cout << "  ⚠️ No hazards found - game will be too easy!" << std::endl;
-        issues = true;
-    }
-
-    if (!issues) {
+    if (check.issues == 0) {
         std::cout << "  ✓ No obvious issues detected" << std::endl;
     }
 
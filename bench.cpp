@@ -0,0 +1,169 @@
+// Micro-benchmarks for the simulation hot paths on synthetic maps.
+// Run: ./hot_and_cold_bench [benchmark-name-filter]
+// Prints one CSV row per benchmark and map size:
+//   benchmark,map,tiles,iterations,min_ns,median_ns
+// Maps and inputs are generated from a fixed seed, so runs are comparable.
+
+#include "include/Simulation.h"
+#include "include/LevelCheck.h"
+#include "include/Log.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct MapSize {
+    int columns;
+    int rows;
+};
+
+// One screen (40x30) up to 100 screens wide by 100 screens tall
+const MapSize MAP_SIZES[] = {
+    {40, 30},
+    {400, 30},
+    {4000, 30},
+    {4000, 300},
+    {4000, 3000},
+};
+
+constexpr int SAMPLES = 7;
+constexpr auto MIN_SAMPLE_TIME = std::chrono::milliseconds(20);
+
+// Bordered map with a ledge row every few rows: runs of wall, gaps and
+// hazard strips on top of the ledges, like the hand-made levels. Rows 1-3
+// stay open so the benchmarks have a safe place to stand.
+std::string writeSyntheticMap(const MapSize& size) {
+    std::filesystem::path path = std::filesystem::temp_directory_path() /
+        ("hot_and_cold_bench_" + std::to_string(size.columns) + "x" + std::to_string(size.rows) + ".txt");
+
+    std::mt19937 rng(12345u + static_cast<unsigned>(size.rows));
+    std::uniform_int_distribution<int> roll(0, 99);
+    const char* hazards[] = {"2", "3", "4"};
+
+    std::ofstream file(path);
+    for (int row = 0; row < size.rows; ++row) {
+        bool border = (row == 0 || row == size.rows - 1);
+        bool ledge = (row > 4 && row % 6 == 0);
+
+        for (int col = 0; col < size.columns; ++col) {
+            const char* code = "0";
+            if (border || col == 0 || col == size.columns - 1) {
+                code = "112";
+            } else if (ledge) {
+                code = (roll(rng) < 80) ? "112" : "0";
+            } else if (row > 4 && row % 6 == 5 && roll(rng) < 15) {
+                code = hazards[roll(rng) % 3];
+            }
+            file << code << (col + 1 < size.columns ? "," : "");
+        }
+        file << "\n";
+    }
+    return path.string();
+}
+
+std::string sizeName(const MapSize& size) {
+    return std::to_string(size.columns) + "x" + std::to_string(size.rows);
+}
+
+// Time `op` in batches long enough for the clock to resolve, report the
+// fastest and the median per-op time over SAMPLES batches
+void measure(std::ostream& out, const std::string& filter, const std::string& name,
+             const MapSize& size, const std::function<void()>& op) {
+    if (!filter.empty() && name.find(filter) == std::string::npos) return;
+
+    using Clock = std::chrono::steady_clock;
+    auto runBatch = [&op](long long iterations) {
+        auto start = Clock::now();
+        for (long long i = 0; i < iterations; ++i) op();
+        return Clock::now() - start;
+    };
+
+    long long iterations = 1;
+    while (runBatch(iterations) < MIN_SAMPLE_TIME) {
+        iterations *= 2;
+    }
+
+    std::vector<double> perOp;
+    for (int s = 0; s < SAMPLES; ++s) {
+        double ns = std::chrono::duration<double, std::nano>(runBatch(iterations)).count();
+        perOp.push_back(ns / static_cast<double>(iterations));
+    }
+    std::sort(perOp.begin(), perOp.end());
+
+    out << name << ',' << sizeName(size) << ',' << static_cast<long long>(size.columns) * size.rows
+        << ',' << iterations << ',' << perOp.front() << ',' << perOp[SAMPLES / 2] << std::endl;
+}
+
+void benchMap(std::ostream& out, const std::string& filter, const MapSize& size) {
+    std::string path = writeSyntheticMap(size);
+
+    Board board(path);
+    measure(out, filter, "Board::loadMap", size, [&] { board.loadMap(path); });
+
+    std::vector<char> text;
+    LevelCheck::readFile(path, text);
+    measure(out, filter, "LevelCheck::check", size, [&] { LevelCheck::check(std::string_view(text.data(), text.size())); });
+    measure(out, filter, "Board::generateCollidables", size, [&] { board.generateCollidables(); });
+
+    Simulation simulation;
+    measure(out, filter, "Simulation::loadLevel", size, [&] { simulation.loadLevel(path); });
+    measure(out, filter, "Simulation::restart", size, [&] { simulation.restart(); });
+    simulation.loadLevel(path);
+
+    // Park both players in the open strip under the ceiling, clear of
+    // every hazard, gate, plate and door zone
+    Character* hot = simulation.getHotPlayer();
+    Character* cold = simulation.getColdPlayer();
+    const sf::Vector2f hotStart(3.0f * Board::CHUNK_SIZE, 1.0f * Board::CHUNK_SIZE);
+    const sf::Vector2f coldStart(20.0f * Board::CHUNK_SIZE, 1.0f * Board::CHUNK_SIZE);
+    hot->setPosition(hotStart);
+    cold->setPosition(coldStart);
+
+    // Run, jump and land against the ceiling and side wall; reset every so
+    // often so the player keeps exercising the same cells
+    hot->setMovingLeft(true);
+    long long step = 0;
+    const std::vector<sf::FloatRect> noObstacles;
+    measure(out, filter, "Character::update", size, [&] {
+        hot->setJumping((step & 15) == 0);
+        hot->update(simulation.getBoard(), noObstacles);
+        if ((++step & 255) == 0) hot->setPosition(hotStart);
+    });
+    hot->setMovingLeft(false);
+    hot->setJumping(false);
+    hot->setPosition(hotStart);
+
+    measure(out, filter, "Simulation::checkDeath", size, [&] { simulation.checkDeath(); });
+
+    const std::vector<Character>& players = simulation.getPlayers();
+    LogicNetwork& logic = simulation.getLogic();
+    measure(out, filter, "LogicNetwork::update", size, [&] { logic.update(players); });
+
+    std::filesystem::remove(path);
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    std::string filter = (argc > 1) ? argv[1] : "";
+
+    // Only the CSV goes to stdout
+    Logger::instance().setMinimumLevel(LogLevel::Off);
+
+    std::ostream& out = std::cout;
+    out << std::fixed << std::setprecision(1);
+    out << "benchmark,map,tiles,iterations,min_ns,median_ns" << std::endl;
+    for (const MapSize& size : MAP_SIZES) {
+        benchMap(out, filter, size);
+    }
+
+    return 0;
+}
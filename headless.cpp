@@ -0,0 +1,369 @@
+// Headless runner: steps a level with no window or GL context.
+// Run: ./hot_and_cold_headless [level] [ticks]
+//      ./hot_and_cold_headless --replay <file.hcr>
+//      ./hot_and_cold_headless --worlds N [--threads N] [--ticks N] [--level N] [--seed N]
+//      ./hot_and_cold_headless --check-jump [level]
+
+#include "include/Simulation.h"
+#include "include/Controller.h"
+#include "include/Replay.h"
+#include "include/Log.h"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const char* stateName(GameState state) {
+    switch (state) {
+        case GameState::Playing: return "Playing";
+        case GameState::Won:     return "Won";
+        case GameState::Lost:    return "Lost";
+    }
+    return "Unknown";
+}
+
+void printOutcome(const char* label, const Replay::Outcome& outcome) {
+    std::cout << label << ": " << stateName(outcome.state)
+              << " hot (" << outcome.hotPosition.x << ", " << outcome.hotPosition.y << ")"
+              << (outcome.hotDead ? " dead" : "")
+              << " cold (" << outcome.coldPosition.x << ", " << outcome.coldPosition.y << ")"
+              << (outcome.coldDead ? " dead" : "") << std::endl;
+}
+
+// Feed recorded inputs back through a fresh simulation at full speed and
+// check it ends exactly where the recording did
+int runReplay(const std::string& path) {
+    Replay replay;
+    if (!replay.loadFromFile(path)) return 1;
+
+    Simulation simulation(replay.getLevel());
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& run : replay.getRuns()) {
+        for (std::uint32_t i = 0; i < run.ticks; ++i) {
+            Replay::applyInputs(simulation, run.inputs);
+            simulation.update();
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    Replay::Outcome expected = replay.getOutcome();
+    Replay::Outcome actual = Replay::captureOutcome(simulation);
+
+    // Let the run's own log lines come out before the report
+    Logger::instance().flush();
+
+    std::cout << "=== REPLAY ===" << std::endl;
+    std::cout << "File: " << path << std::endl;
+    std::cout << "Level: " << replay.getLevel() << std::endl;
+    std::cout << "Ticks: " << replay.getTickCount() << " (" << replay.getRuns().size() << " input runs)" << std::endl;
+    std::cout << "Time: " << seconds * 1000.0 << " ms" << std::endl;
+    printOutcome("Recorded", expected);
+    printOutcome("Replayed", actual);
+
+    bool match = expected.state == actual.state &&
+                 expected.hotPosition == actual.hotPosition &&
+                 expected.coldPosition == actual.coldPosition &&
+                 expected.hotDead == actual.hotDead &&
+                 expected.coldDead == actual.coldDead;
+
+    std::cout << (match ? "MATCH" : "MISMATCH") << std::endl;
+    return match ? 0 : 1;
+}
+
+// What pressing jump from standing does, driven through Controller the way
+// Game::tick does. The key stays down for `holdTicks`; with `repeat` it is
+// pressed again every few ticks meanwhile, like OS key repeat does.
+struct JumpResult {
+    float height = 0.0f;
+    int jumps = 0;   // times the player left the ground
+};
+
+JumpResult jumpFrom(int levelNumber, int holdTicks, bool repeat) {
+    Simulation simulation(levelNumber);
+    Controller controller;
+    auto step = [&] {
+        Replay::applyInputs(simulation, controller.sample(Replay::pendingJumps(simulation)));
+        simulation.update();
+    };
+
+    for (int tick = 0; tick < 2 * Simulation::TICKS_PER_SECOND; ++tick) step();   // land first
+    const Character* hot = simulation.getHotPlayer();
+    const float ground = hot->getRect().position.y;
+
+    // About what a desktop sends: a pause, then ~30 repeats a second
+    const int REPEAT_DELAY = 30;
+    const int REPEAT_INTERVAL = 2;
+
+    JumpResult result;
+    float apex = ground;
+    bool grounded = true;
+    controller.handleEvent(sf::Event::KeyPressed{sf::Keyboard::Key::Up});
+    for (int tick = 0; tick < 4 * Simulation::TICKS_PER_SECOND; ++tick) {
+        if (tick == holdTicks) controller.handleEvent(sf::Event::KeyReleased{sf::Keyboard::Key::Up});
+        if (repeat && tick < holdTicks && tick >= REPEAT_DELAY && tick % REPEAT_INTERVAL == 0) {
+            controller.handleEvent(sf::Event::KeyPressed{sf::Keyboard::Key::Up});
+        }
+        step();
+
+        const float y = hot->getRect().position.y;
+        if (grounded && y < ground) ++result.jumps;
+        grounded = y >= ground;
+        apex = std::min(apex, y);
+    }
+    result.height = ground - apex;
+    return result;
+}
+
+// A held jump key jumps once, exactly as high as a single press, even
+// with the key repeating
+int checkJump(int levelNumber) {
+    const int HOLD = 3 * Simulation::TICKS_PER_SECOND;   // long enough to land and go again
+    const JumpResult tapped = jumpFrom(levelNumber, 1, false);
+    const JumpResult held = jumpFrom(levelNumber, HOLD, false);
+    const JumpResult repeated = jumpFrom(levelNumber, HOLD, true);
+
+    Logger::instance().flush();
+    std::cout << "=== JUMP CHECK ===" << std::endl;
+    std::cout << "Level: " << levelNumber << std::endl;
+    std::cout << "Tapped: " << tapped.height << " px, " << tapped.jumps << " jump(s)" << std::endl;
+    std::cout << "Held: " << held.height << " px, " << held.jumps << " jump(s)" << std::endl;
+    std::cout << "Held, key repeating: " << repeated.height << " px, " << repeated.jumps << " jump(s)" << std::endl;
+
+    bool same = tapped.height > 0.0f && tapped.jumps == 1;
+    for (const JumpResult& result : {held, repeated}) {
+        same = same && result.height == tapped.height && result.jumps == 1;
+    }
+    std::cout << (same ? "MATCH" : "MISMATCH") << std::endl;
+    return same ? 0 : 1;
+}
+
+struct WorldOptions {
+    int worlds = 0;
+    unsigned int threads = 0;      // 0: one per hardware thread
+    long long ticks = 10000;       // per world
+    int level = 0;                 // 0: every level in data/, in turn
+    std::uint32_t seed = 1;
+};
+
+// What one world did; each world writes only its own
+struct WorldResult {
+    long long ticks = 0;
+    int wins = 0;
+    int losses = 0;
+    std::uint64_t checksum = 0;   // of where each episode ended
+};
+
+// Random inputs, each held for a while like a player would: the fuzzing
+// and playtesting load. Seeded per world so a run can be repeated.
+void runWorld(int levelNumber, std::uint32_t seed, long long ticks, WorldResult& result) {
+    Simulation simulation(levelNumber);
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> inputRoll(0, 63);
+    std::uniform_int_distribution<int> holdRoll(4, 30);
+
+    auto endEpisode = [&] {
+        for (const auto& player : simulation.getPlayers()) {
+            sf::Vector2f position = player.getRect().position;
+            result.checksum = result.checksum * 1000003u + static_cast<std::uint64_t>(position.x * 16.0f);
+            result.checksum = result.checksum * 1000003u + static_cast<std::uint64_t>(position.y * 16.0f);
+        }
+    };
+
+    // Keys as Controller::sample sees them: a jump key still down only
+    // counts until its press has been used, so no held-jump physics
+    const std::uint8_t jumps = Replay::HOT_JUMP | Replay::COLD_JUMP;
+    std::uint8_t inputs = 0;
+    std::uint8_t pressed = 0;
+    int held = 0;
+    for (long long tick = 0; tick < ticks; ++tick) {
+        if (held-- <= 0) {
+            const std::uint8_t previous = inputs;
+            inputs = static_cast<std::uint8_t>(inputRoll(rng));
+            pressed = inputs & ~previous & jumps;
+            held = holdRoll(rng);
+        }
+        const std::uint8_t heldJumps = inputs & jumps & Replay::pendingJumps(simulation);
+        Replay::applyInputs(simulation, static_cast<std::uint8_t>((inputs & ~jumps) | pressed | heldJumps));
+        pressed = 0;
+        simulation.update();
+
+        if (simulation.getGameState() != GameState::Playing) {
+            (simulation.getGameState() == GameState::Won) ? ++result.wins : ++result.losses;
+            endEpisode();
+            simulation.restart();
+        }
+    }
+    endEpisode();
+    result.ticks = ticks;
+}
+
+// Many independent levels at once, spread over a pool of threads. Worlds
+// share nothing they write to, so the checksum is the same for any
+// thread count.
+int runWorlds(const WorldOptions& options) {
+    std::vector<int> levels;
+    if (options.level > 0) {
+        levels.push_back(options.level);
+    } else {
+        for (int level = 1; std::filesystem::exists(Simulation::getLevelPath(level)); ++level) levels.push_back(level);
+    }
+    if (levels.empty()) {
+        std::cerr << "No levels found" << std::endl;
+        return 1;
+    }
+
+    // Every world loads its level and plays it to death or victory a few
+    // hundred times; only warnings are worth seeing
+    Logger::instance().setMinimumLevel(LogLevel::Warning);
+
+    const unsigned int hardware = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned int threads = static_cast<unsigned int>(
+        std::min<long long>(options.threads ? options.threads : hardware, options.worlds));
+
+    // Threads take the next world until there are none left
+    std::vector<WorldResult> results(options.worlds);
+    std::atomic<int> nextWorld(0);
+    auto work = [&] {
+        for (int world = nextWorld++; world < options.worlds; world = nextWorld++) {
+            runWorld(levels[world % levels.size()], options.seed + static_cast<std::uint32_t>(world),
+                     options.ticks, results[world]);
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned int i = 0; i < threads; ++i) workers.emplace_back(work);
+    for (auto& worker : workers) worker.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    WorldResult total;
+    for (const WorldResult& result : results) {
+        total.ticks += result.ticks;
+        total.wins += result.wins;
+        total.losses += result.losses;
+        total.checksum = total.checksum * 31u + result.checksum;
+    }
+
+    // More threads than cores only take turns
+    const unsigned int cores = std::min(threads, hardware);
+    const double ticksPerSecond = seconds > 0.0 ? total.ticks / seconds : 0.0;
+
+    Logger::instance().flush();
+
+    std::cout << "=== WORLDS ===" << std::endl;
+    std::cout << "Worlds: " << options.worlds << " (" << levels.size() << " levels, seed " << options.seed << ")" << std::endl;
+    std::cout << "Threads: " << threads << " on " << hardware << " hardware threads" << std::endl;
+    std::cout << "Ticks: " << total.ticks << " (" << options.ticks << " per world)" << std::endl;
+    std::cout << "Episodes: " << total.wins << " won, " << total.losses << " lost" << std::endl;
+    std::cout << "Time: " << seconds * 1000.0 << " ms" << std::endl;
+    std::cout << "Ticks/sec: " << static_cast<long long>(ticksPerSecond) << std::endl;
+    std::cout << "Ticks/sec/core: " << static_cast<long long>(ticksPerSecond / cores) << std::endl;
+    std::cout << "Checksum: " << std::hex << std::setw(16) << std::setfill('0') << total.checksum << std::dec << std::endl;
+    return 0;
+}
+
+int usage() {
+    std::cerr << "Usage: hot_and_cold_headless [level] [ticks]\n"
+                 "       hot_and_cold_headless --replay <file.hcr>\n"
+                 "       hot_and_cold_headless --check-jump [level]\n"
+                 "       hot_and_cold_headless --worlds N [--threads N] [--ticks N] [--level N] [--seed N]"
+              << std::endl;
+    return 1;
+}
+
+// The whole argument as a number of at least `min`; no signs wrapping
+// around, no trailing junk
+template <typename Number>
+bool parseNumber(const char* text, Number min, Number& value) {
+    std::string_view digits(text);
+    Number parsed{};
+    auto [end, error] = std::from_chars(digits.data(), digits.data() + digits.size(), parsed);
+    if (error != std::errc() || end != digits.data() + digits.size() || parsed < min) return false;
+    value = parsed;
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 2 && std::string(argv[1]) == "--replay") {
+        return runReplay(argv[2]);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--check-jump") {
+        // Level 1 has a low ceiling over the spawn point
+        int level = 2;
+        if (argc > 3 || (argc > 2 && !parseNumber(argv[2], 1, level))) return usage();
+        return checkJump(level);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--worlds") {
+        WorldOptions options;
+        if (argc < 3 || !parseNumber(argv[2], 1, options.worlds)) return usage();
+        for (int i = 3; i < argc; i += 2) {
+            std::string arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : "";
+            bool parsed = false;
+            if (arg == "--threads") {
+                parsed = parseNumber(value, 0u, options.threads);
+            } else if (arg == "--ticks") {
+                parsed = parseNumber(value, 1LL, options.ticks);
+            } else if (arg == "--level") {
+                parsed = parseNumber(value, 0, options.level);
+            } else if (arg == "--seed") {
+                parsed = parseNumber(value, std::uint32_t{0}, options.seed);
+            }
+            if (!parsed) return usage();
+        }
+        return runWorlds(options);
+    }
+
+    int levelNumber = 1;
+    long long ticks = 100000;
+    if (argc > 3 || (argc > 1 && !parseNumber(argv[1], 1, levelNumber)) ||
+        (argc > 2 && !parseNumber(argv[2], 0LL, ticks))) {
+        return usage();
+    }
+
+    Simulation simulation(levelNumber);
+
+    auto start = std::chrono::steady_clock::now();
+    long long ticksRun = 0;
+    while (ticksRun < ticks && simulation.getGameState() == GameState::Playing) {
+        simulation.update();
+        ++ticksRun;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    Logger::instance().flush();
+
+    std::cout << "=== HEADLESS RUN ===" << std::endl;
+    std::cout << "Level: " << levelNumber << std::endl;
+    std::cout << "Ticks: " << ticksRun << std::endl;
+    std::cout << "Time: " << seconds * 1000.0 << " ms" << std::endl;
+    if (seconds > 0.0) {
+        std::cout << "Ticks/sec: " << static_cast<long long>(ticksRun / seconds) << std::endl;
+    }
+    std::cout << "State: " << stateName(simulation.getGameState()) << std::endl;
+
+    for (const auto& player : simulation.getPlayers()) {
+        sf::FloatRect rect = player.getRect();
+        std::cout << "  " << player.getType() << ": (" << rect.position.x << ", " << rect.position.y << ")"
+                  << (player.isDead() ? " dead" : "") << std::endl;
+    }
+
+    return 0;
+}
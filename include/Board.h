@@ -2,34 +2,67 @@
 #define BOARD_H
 
 #include <SFML/Graphics.hpp>
+#include <array>
 #include <vector>
-#include <map>
+#include <memory>
 #include <string>
+#include "Tiles.h"
+
+// Board tile textures packed into one texture (see Board::loadImages)
+struct TileAtlas {
+    sf::Texture texture;
+    std::array<sf::IntRect, Tiles::COUNT> rects;   // by TileId, empty if not packed
+    sf::IntRect blankRect;   // plain white cell, for untextured tiles
+};
 
 class Board {
 private:
-    std::vector<std::vector<std::string>> m_gameMap;
-    std::map<std::string, sf::Texture> m_textures;
+    std::vector<TileId> m_tiles;   // row-major, m_gridColumns per row
+    std::shared_ptr<const sf::Texture> m_background;
+    std::shared_ptr<const TileAtlas> m_tileAtlas;
     std::vector<sf::FloatRect> m_solidBlocks;
     std::vector<sf::FloatRect> m_lavaPools;
     std::vector<sf::FloatRect> m_waterPools;
     std::vector<sf::FloatRect> m_gooPools;
+    std::vector<std::uint8_t> m_hazardMask;   // TILE_HAZARD bits per cell, row-major
 
-    static constexpr int CHUNK_SIZE = 16;
+    int m_gridColumns;
+    int m_gridRows;
+
+    bool m_mergeCollidables;
 
 public:
-    Board(const std::string& path);
+    static constexpr int CHUNK_SIZE = 16;
+
+    Board(const std::string& path, bool mergeCollidables = true);
 
     void loadMap(const std::string& path);
     void loadImages();
     void generateCollidables();
 
+    // Every image file loadImages() reads
+    static std::vector<std::string> getImagePaths();
+
     const std::vector<sf::FloatRect>& getSolidBlocks() const;
     const std::vector<sf::FloatRect>& getLavaPools() const;
     const std::vector<sf::FloatRect>& getWaterPools() const;
     const std::vector<sf::FloatRect>& getGooPools() const;
-    const std::map<std::string, sf::Texture>& getTextures() const;
-    const std::vector<std::vector<std::string>>& getGameMap() const;
+    const sf::Texture* getBackground() const;
+    const TileAtlas* getTileAtlas() const;
+    const std::vector<TileId>& getTiles() const;
+
+    // TILE_LAVA/WATER/GOO bits of every hazard the rect overlaps
+    std::uint8_t hazardsOverlapping(const sf::FloatRect& rect) const;
+
+    TileId getTile(int column, int row) const;
+    bool isSolidCell(int column, int row) const;
+    int getGridColumns() const;
+    int getGridRows() const;
+    sf::Vector2f getWorldSize() const;   // in pixels
+
+private:
+    void mergeSolidBlocks();
+    void mergeHazardRuns(TileId hazardTile, std::vector<sf::FloatRect>& pools);
 };
 
 #endif // BOARD_H
@@ -0,0 +1,28 @@
+#ifndef CAMERA_H
+#define CAMERA_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// World view that follows the players. Centres on all targets, zooms out
+// (up to MAX_ZOOM, and no further than the level allows) when they drift
+// apart, and never shows space outside the level. A level smaller than the
+// screen is centred instead.
+class Camera {
+private:
+    sf::View m_view;
+    sf::Vector2f m_screenSize;
+
+    static constexpr float MAX_ZOOM = 2.0f;
+    static constexpr float MARGIN = 96.0f;   // pixels kept around the targets
+
+public:
+    explicit Camera(const sf::Vector2f& screenSize);
+
+    void follow(const std::vector<sf::FloatRect>& targets, const sf::Vector2f& worldSize);
+
+    const sf::View& getView() const;
+    sf::FloatRect getVisibleArea() const;
+};
+
+#endif // CAMERA_H
@@ -4,14 +4,40 @@
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <optional>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "Tiles.h"
 
 class Board;
 
+// Which player a Character is; fixed at construction
+enum class CharacterKind : std::uint8_t {
+    Hot,
+    Cold
+};
+
+// Plain value type (no virtuals) so players can live contiguously in a
+// std::vector; everything kind-specific is looked up from m_kind.
 class Character {
+public:
+    // Everything that changes while playing; see Simulation::restart()
+    struct State {
+        sf::FloatRect rect;
+        sf::Vector2f previousPosition;
+        float yVelocity;
+        int airTimer;
+        bool isAlive;
+        bool isJumping;
+        bool movingRight;
+        bool movingLeft;
+    };
+
 protected:
     sf::FloatRect m_rect;
+    sf::Vector2f m_previousPosition;   // at the start of the current tick
     std::optional<sf::Sprite> m_sprite;
-    sf::Texture m_texture;
+    std::shared_ptr<const sf::Texture> m_texture;
     bool m_isAlive;
     float m_yVelocity;
     bool m_isJumping;
@@ -19,19 +45,29 @@ protected:
     bool m_movingLeft;
     int m_airTimer;
 
-    std::string m_type;
+    CharacterKind m_kind;
+    std::uint8_t m_lethalHazards;   // TileFlags hazards that kill this character
 
 public:
-    Character(const sf::Vector2f& pos);
-    virtual ~Character() = default;
+    Character(CharacterKind kind, const sf::Vector2f& pos);
 
-    virtual void update(Board& board);
-    virtual void draw(sf::RenderWindow& window);
-    virtual void kill();
+    void update(const Board& board, const std::vector<sf::FloatRect>& obstacles);
+    void loadImages();
+    static std::vector<std::string> getImagePaths();   // for both kinds
+    void draw(sf::RenderTarget& target, float alpha = 1.0f);
+    void kill();
+
+    void storePreviousPosition();
+
+    State saveState() const;
+    void restoreState(const State& state);
 
     bool isDead() const;
     sf::FloatRect getRect() const;
-    std::string getType() const;
+    sf::Vector2f getInterpolatedPosition(float alpha) const;   // where draw() puts the sprite
+    CharacterKind getKind() const;
+    std::string getType() const;   // "hot" / "cold", for logs
+    std::uint8_t getLethalHazards() const;
 
     // NEW: Add setPosition for gate collision
     void setPosition(const sf::Vector2f& pos);
@@ -41,21 +77,9 @@ public:
     void setMovingLeft(bool moving);
     void setJumping(bool jumping);
 
-protected:
-    void calcMovement();
-    void handleCollisions(Board& board);
-};
-
-class Hot : public Character {
-public:
-    Hot(const sf::Vector2f& pos);
-    void update(Board& board) override;
-};
-
-class Cold : public Character {
-public:
-    Cold(const sf::Vector2f& pos);
-    void update(Board& board) override;
+    bool isMovingRight() const;
+    bool isMovingLeft() const;
+    bool isJumping() const;
 };
 
 #endif // CHARACTER_H
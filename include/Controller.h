@@ -2,22 +2,85 @@
 #define CONTROLLER_H
 
 #include <SFML/Graphics.hpp>
-#include "Character.h"
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
 
+// Keyboard and gamepad input for both players, turned into one byte of
+// Replay::InputBits per tick. Events only update what is held; nothing
+// reaches the simulation until sample() is called at the start of a tick,
+// so each tick sees one consistent snapshot wherever in the frame the
+// events arrived. Which keys and pad inputs drive each action is a table
+// loaded from a config file (data/controls.cfg) and can be rebound.
 class Controller {
 public:
-    virtual ~Controller() = default;
-    virtual void controlPlayer(const sf::Event& event, Character& player) = 0;
-};
+    // Same order as Replay::InputBits
+    enum class Action : std::uint8_t {
+        HotRight,
+        HotLeft,
+        HotJump,
+        ColdRight,
+        ColdLeft,
+        ColdJump,
+        COUNT
+    };
+    static constexpr std::size_t ACTION_COUNT = static_cast<std::size_t>(Action::COUNT);
 
-class ArrowsController : public Controller {
-public:
-    void controlPlayer(const sf::Event& event, Character& player) override;
-};
+    struct Binding {
+        enum class Type : std::uint8_t { Key, PadButton, PadAxis };
+
+        Type type = Type::Key;
+        sf::Keyboard::Key key = sf::Keyboard::Key::Unknown;
+        unsigned int pad = 0;
+        unsigned int button = 0;
+        sf::Joystick::Axis axis = sf::Joystick::Axis::X;
+        bool positive = true;   // PadAxis: which way the stick is pushed
+    };
+
+    static constexpr float AXIS_THRESHOLD = 50.0f;   // of 100, for an axis to count as pressed
+
+private:
+    std::array<std::vector<Binding>, ACTION_COUNT> m_bindings;
+
+    // What is held right now, from events
+    std::bitset<sf::Keyboard::KeyCount> m_keys;
+    std::array<std::uint32_t, sf::Joystick::Count> m_padButtons;   // bit per button
+    std::array<std::array<float, sf::Joystick::AxisCount>, sf::Joystick::Count> m_padAxes;
+
+    // Actions pressed since the last sample, so a tap shorter than a tick
+    // still reaches the simulation
+    std::uint8_t m_tapped;
 
-class WASDController : public Controller {
 public:
-    void controlPlayer(const sf::Event& event, Character& player) override;
+    Controller();   // arrow keys for hot, WASD for cold
+
+    // "action = binding, binding, ..." per line, e.g. "hot_jump = Up, Pad0.Button0".
+    // An action listed replaces its bindings; bad lines, and the game's own
+    // command keys (Esc, R, M, F3), are logged and skipped. False if the file can't be read, leaving the bindings as they were.
+    bool loadBindings(const std::string& path);
+    void setBindings(Action action, std::vector<Binding> bindings);
+    const std::vector<Binding>& getBindings(Action action) const;
+
+    void handleEvent(const sf::Event& event);
+    void releaseAll();   // when events may have been missed, so nothing sticks
+
+    // Inputs for the coming tick: movement held plus anything tapped since.
+    // Jumps are presses, like the old KeyPressed handling: a jump key counts
+    // while held only for the players in `pendingJumps` (Replay::pendingJumps),
+    // whose last press hasn't been used yet, e.g. because they are mid-air.
+    std::uint8_t sample(std::uint8_t pendingJumps = 0);
+
+    // "Left", "W", "Pad0.Button3", "Pad1.PovY-"
+    static bool parseBinding(std::string_view text, Binding& binding);
+    static std::string describe(const Binding& binding);
+    static const char* actionName(Action action);   // "hot_left"
+
+private:
+    bool isHeld(const Binding& binding) const;
+    void tap(const Binding& pressed);
 };
 
 #endif // CONTROLLER_H
@@ -3,51 +3,68 @@
 
 #include <SFML/Graphics.hpp>
 #include <optional>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
 #include "Character.h"
 
+// Fire doors open for Hot, water doors for Cold
+enum class DoorKind : std::uint8_t {
+    Fire,
+    Water
+};
+
+// Plain value type kept contiguously by Simulation; fire/water behaviour
+// comes from the kind tag.
 class Doors {
-protected:
+public:
+    struct State {
+        sf::Vector2f doorLocation;
+        sf::Vector2f previousDoorLocation;
+        float heightRaised;
+        bool isOpen;
+        bool playerAtDoor;
+    };
+
+private:
     sf::FloatRect m_rect;
     std::optional<sf::Sprite> m_doorSprite;
     std::optional<sf::Sprite> m_frameSprite;
     std::optional<sf::Sprite> m_backgroundSprite;
-    sf::Texture m_doorTexture;
-    sf::Texture m_frameTexture;
-    sf::Texture m_backgroundTexture;
+    std::shared_ptr<const sf::Texture> m_doorTexture;
+    std::shared_ptr<const sf::Texture> m_frameTexture;
+    std::shared_ptr<const sf::Texture> m_backgroundTexture;
 
     bool m_isOpen;
     float m_heightRaised;
     bool m_playerAtDoor;
     sf::Vector2f m_doorLocation;
+    sf::Vector2f m_previousDoorLocation;   // at the start of the current tick
+    DoorKind m_kind;
 
     static constexpr int CHUNK_SIZE = 16;
     static constexpr float DOOR_SPEED = 1.5f;
 
 public:
-    Doors(const sf::Vector2f& doorLocation);
-    virtual ~Doors() = default;
+    Doors(DoorKind kind, const sf::Vector2f& doorLocation);
 
-    virtual void tryOpen(Character& player) = 0;
+    // Driven by the logic network: the opener is inside getTriggerZone()
+    void setPlayerAtDoor(bool atDoor);
+    void loadImages();
+    static std::vector<std::string> getImagePaths();   // for both kinds
     void tryRaiseDoor();
-    void draw(sf::RenderWindow& window);
+    void storePreviousPosition();
+
+    State saveState() const;
+    void restoreState(const State& state);
+    void draw(sf::RenderTarget& target, float alpha = 1.0f);
 
     bool isOpen() const;
     sf::FloatRect getRect() const;
-
-protected:
-    void loadCommonImages();
-};
-
-class FireDoor : public Doors {
-public:
-    FireDoor(const sf::Vector2f& doorLocation);
-    void tryOpen(Character& player) override;
-};
-
-class WaterDoor : public Doors {
-public:
-    WaterDoor(const sf::Vector2f& doorLocation);
-    void tryOpen(Character& player) override;
+    sf::FloatRect getTriggerZone() const;
+    DoorKind getKind() const;
+    CharacterKind getOpener() const;   // the player this door opens for
 };
 
 #endif // DOORS_H
@@ -2,60 +2,68 @@
 #define GAME_H
 
 #include <SFML/Graphics.hpp>
-#include <list>
-#include <vector>
 #include <memory>
-#include "Board.h"
-#include "Character.h"
-#include "Doors.h"
-#include "Gates.h"
-#include "LevelSelect.h"
-#include "Controller.h"
-
-enum class GameState {
-    Playing,
-    Won,
-    Lost
-};
+#include "Scene.h"
+#include "SceneStack.h"
+#include "Simulation.h"
+#include "TileLayer.h"
+#include "Camera.h"
+#include "Replay.h"
+#include "LevelPreloader.h"
+#include "Profiler.h"
+#if HOT_AND_COLD_PROFILING
+#include "ProfilerHud.h"
+#endif
+#include <string>
 
-class Game {
+// Gameplay scene: one level, stepped at a fixed rate and drawn through the
+// camera. Pushes a ResultsScene over itself when the level is won or lost.
+class Game : public Scene {
 private:
-    sf::RenderWindow m_window;
-    Board* m_board;
+    sf::Clock m_startClock;   // construction to first frame, for the load log
+    bool m_drawnFirstFrame;
+
+    SceneStack& m_stack;
+    SceneContext& m_context;
 
-    std::list<Character*> m_players;
-    std::list<Doors*> m_doors;
-    std::list<Gates*> m_gates;
+    Simulation m_simulation;
+    TileLayer m_tileLayer;
+    Camera m_camera;
 
-    Character* m_hotPlayer;
-    Character* m_coldPlayer;
+#if HOT_AND_COLD_PROFILING
+    ProfilerHud m_profilerHud;
+#endif
 
-    std::unique_ptr<ArrowsController> m_arrowsController;
-    std::unique_ptr<WASDController> m_wasdController;
+    // Fixed-step clock: ticks run at Simulation::TICKS_PER_SECOND no matter
+    // how fast frames are drawn
+    sf::Time m_accumulator;
+    float m_alpha;   // how far between the last two ticks this frame is
 
-    GameState m_gameState;
-    int m_currentLevel;
+    static constexpr int MAX_CATCH_UP_TICKS = 5;
 
-    sf::Font m_font;
+    // Input recording; empty directory = off. One file per attempt.
+    Replay m_replay;
+    int m_attempt;
 
 public:
-    Game(int levelNumber = 1);
-    ~Game();
+    Game(SceneStack& stack, SceneContext& context, int levelNumber = 1);
+    ~Game() override;
+
+    void handleEvent(const sf::Event& event) override;
+    void update(sf::Time elapsed) override;
+    void draw(sf::RenderTarget& target) override;
+    void onActivate() override;
 
-    void run();
-    void draw();
-    void update();
-    void checkCollisions();
-    void checkDeath();
-    bool checkWin();
-    bool shouldReturnToMenu() const;
+    void restartLevel();
 
 private:
-    void handleEvents();
-    void cleanup();
-    void drawBoard();
-    void drawGameStateText();
+    void tick();
+    void updateCamera(float alpha);
+    void drawBoard(sf::RenderTarget& target);
     void initializeLevel(int levelNumber);
+    void beginAttempt();
+    void loadImages();
+    void saveReplay();
 };
 
 #endif // GAME_H
@@ -2,12 +2,21 @@
 #define GATES_H
 
 #include <SFML/Graphics.hpp>
-#include <list>
+#include <string>
 #include <vector>
 #include <optional>
+#include <memory>
 #include "Character.h"
 
 class Gates {
+public:
+    struct State {
+        sf::Vector2f gateLocation;
+        sf::FloatRect gateRect;
+        bool isPressed;
+        bool isOpen;
+    };
+
 private:
     // Member variables in order of initialization
     sf::Vector2f m_gateLocation;
@@ -19,24 +28,26 @@ private:
     std::vector<sf::FloatRect> m_plateRects;
     std::optional<sf::Sprite> m_gateSprite;
     std::vector<sf::Sprite> m_plateSprites;
-    sf::Texture m_gateTexture;
-    sf::Texture m_plateTexture;
+    std::shared_ptr<const sf::Texture> m_gateTexture;
+    std::shared_ptr<const sf::Texture> m_plateTexture;
 
     static constexpr int CHUNK_SIZE = 16;
 
 public:
     Gates(const sf::Vector2f& gateLocation, const std::vector<sf::Vector2f>& plateLocations);
 
-    void tryOpen(const std::list<Character*>& players);
-    void draw(sf::RenderWindow& window);
+    // Driven by the logic network: any of this gate's plates pressed
+    void setPressed(bool pressed);
+    void loadImages();
+    static std::vector<std::string> getImagePaths();
+
+    State saveState() const;
+    void restoreState(const State& state);
+    void draw(sf::RenderTarget& target);
 
     sf::FloatRect getGateRect() const;
     const std::vector<sf::FloatRect>& getPlateRects() const;
     bool isOpen() const;
-
-private:
-    void loadImages();
-    bool checkCollision(const sf::FloatRect& rect1, const sf::FloatRect& rect2) const;
 };
 
 #endif // GATES_H
@@ -0,0 +1,80 @@
+#ifndef LEVELCHECK_H
+#define LEVELCHECK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Tiles.h"
+
+// Structural checks on a level file without building a Board. Parses with
+// the same rules as Board::loadMap (CSV tile codes, blank lines skipped),
+// but straight out of a byte buffer and without allocating per row or
+// cell, so a batch of levels is limited by reading the files.
+// No SFML here, like Tiles.h, so standalone tools can use it.
+namespace LevelCheck {
+
+// One screen: the spawn points and doors Simulation places sit inside it
+inline constexpr int MIN_COLUMNS = 40;
+inline constexpr int MIN_ROWS = 30;
+
+inline constexpr int TILE_SIZE = 16;   // Board::CHUNK_SIZE
+
+// A player's hitbox, and where Simulation::setupLevel puts Hot and Cold
+// (top-left corner, in pixels). Simulation and Character use these too.
+inline constexpr int PLAYER_WIDTH = 16;
+inline constexpr int PLAYER_HEIGHT = 32;
+
+struct Rect {
+    int x;
+    int y;
+    int width;
+    int height;
+};
+inline constexpr Rect SPAWN_RECTS[] = {
+    {48, 400, PLAYER_WIDTH, PLAYER_HEIGHT},    // Hot
+    {560, 400, PLAYER_WIDTH, PLAYER_HEIGHT},   // Cold
+};
+inline constexpr std::size_t SPAWN_COUNT = sizeof(SPAWN_RECTS) / sizeof(SPAWN_RECTS[0]);
+inline constexpr TileId OUTSIDE = Tiles::COUNT;   // spawn rect reaches beyond the map
+
+enum class Issue : std::uint8_t {
+    Empty,          // no rows at all
+    TooSmall,       // under MIN_COLUMNS x MIN_ROWS
+    SpawnBlocked,   // a spawn rect over a wall, a hazard or off the map
+    RaggedRows,     // rows of different widths; the game pads them
+    UnknownCodes,   // codes missing from Tiles::PROPERTIES; drawn as walls
+    NoHazards,      // no lava or water
+    COUNT
+};
+
+const char* issueName(Issue issue);   // "too_small", for reports
+bool isError(Issue issue);            // the rest are warnings
+
+struct Result {
+    int rows = 0;
+    int columns = 0;          // widest row
+    int raggedRows = 0;       // rows not as wide as the first
+    std::size_t tileCounts[Tiles::COUNT] = {};
+    // Per spawn: OUTSIDE if its rect leaves the map, else the first
+    // non-empty cell it covers, else Tiles::EMPTY
+    TileId spawnTiles[SPAWN_COUNT] = {};
+    std::uint32_t issues = 0;   // bit per Issue
+
+    bool has(Issue issue) const;
+    bool passed() const;   // no errors; warnings are fine
+};
+
+// Parses and checks a whole level file. If `tiles` is given it receives
+// every row back to back (each at its own width) and `rowStarts` where
+// each begins; both keep their capacity between calls.
+Result check(std::string_view text, std::vector<TileId>* tiles = nullptr,
+             std::vector<std::size_t>* rowStarts = nullptr);
+
+// Whole file into `buffer`, reusing its capacity; false if unreadable
+bool readFile(const std::string& path, std::vector<char>& buffer);
+
+}
+
+#endif // LEVELCHECK_H
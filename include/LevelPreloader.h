@@ -0,0 +1,48 @@
+#ifndef LEVELPRELOADER_H
+#define LEVELPRELOADER_H
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "Board.h"
+
+// Does the CPU side of loading a level on a worker thread while the menu (or
+// a finished level) sits idle: parses the map into a Board and decodes every
+// game image into ImageCache. Nothing here touches the GPU; textures are
+// still created on the main thread, they just skip the PNG decode.
+//
+// One level is kept ready at a time. A newer request replaces an older one.
+class LevelPreloader {
+private:
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;     // new request or shutdown
+    std::condition_variable m_parsed;   // a board finished parsing
+
+    int m_requestedLevel;   // 0 = nothing wanted
+    int m_parsingLevel;     // 0 = worker idle
+    int m_readyLevel;       // level m_ready belongs to, 0 = none
+    std::unique_ptr<Board> m_ready;
+    bool m_stopping;
+
+public:
+    LevelPreloader();
+    ~LevelPreloader();
+
+    LevelPreloader(const LevelPreloader&) = delete;
+    LevelPreloader& operator=(const LevelPreloader&) = delete;
+
+    // Start preparing a level; cheap to call every time the selection moves
+    void request(int levelNumber);
+
+    // The parsed board for `levelNumber`, or nullptr if it was never asked
+    // for (the caller then loads it itself). Waits if it is mid-parse.
+    std::unique_ptr<Board> take(int levelNumber);
+
+private:
+    void run();
+    static void decodeImages();
+};
+
+#endif // LEVELPRELOADER_H
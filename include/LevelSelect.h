@@ -5,11 +5,12 @@
 #include <map>
 #include <string>
 #include <optional>
+#include <memory>
 
 class LevelSelect {
 private:
-    sf::Texture m_background;
-    std::map<int, sf::Texture> m_levelTextures;
+    std::shared_ptr<const sf::Texture> m_background;
+    std::map<int, std::shared_ptr<const sf::Texture>> m_levelTextures;
     std::optional<sf::Sprite> m_backgroundSprite;
     std::map<int, sf::Sprite> m_levelSprites;
 
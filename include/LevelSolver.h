@@ -0,0 +1,53 @@
+#ifndef LEVELSOLVER_H
+#define LEVELSOLVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Searches a level for inputs that get both players through their doors,
+// stepping the real Simulation (same physics, gates, plates and doors as the
+// game). Each search step holds one player's input (or nobody's) for a few
+// ticks while the other stands still; that is enough for the usual "one
+// holds the plate, the other goes through" levels and keeps the branching
+// small. States are deduplicated on a quantised hash of both players, the
+// doors and the gates, and expanded by a pool of threads that steal work
+// from each other's queues, nearest the doors first.
+//
+// Each player is first searched alone with every gate held open. If one
+// cannot reach its door even then, the level is unsolvable and the much
+// larger two-player search is skipped.
+//
+// A witness is a real solution: replaying it from the start wins, and it
+// only jumps the way a held key can, so it can be played on a keyboard. Not
+// finding one only means no solution exists within that search model.
+class LevelSolver {
+public:
+    struct Options {
+        unsigned int threads = 0;         // 0: one per hardware thread
+        int ticksPerStep = 8;             // how long each search step holds its input
+        std::uint32_t maxTicks = 60 * 180;
+        std::size_t maxStates = 4000000;
+    };
+
+    enum class Verdict {
+        Solved,
+        NoSolution,   // every reachable state searched
+        GaveUp        // hit maxStates first
+    };
+
+    struct Result {
+        Verdict verdict = Verdict::NoSolution;
+        std::vector<std::uint8_t> witness;   // Replay::InputBits, one per tick
+        std::string stuckPlayer;   // "hot"/"cold": can't reach its door even alone
+        std::size_t statesExplored = 0;
+        std::size_t duplicates = 0;
+        unsigned int threads = 0;
+        double seconds = 0.0;
+    };
+
+    static Result solve(const std::string& levelFile, const Options& options);
+};
+
+#endif // LEVELSOLVER_H
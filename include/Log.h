@@ -0,0 +1,183 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+
+// Statements below this level are not compiled at all: 0 debug, 1 info,
+// 2 warning, 3 error, 4 nothing. Release builds (NDEBUG) drop debug.
+#ifndef HOT_AND_COLD_LOG_LEVEL
+#ifdef NDEBUG
+#define HOT_AND_COLD_LOG_LEVEL 1
+#else
+#define HOT_AND_COLD_LOG_LEVEL 0
+#endif
+#endif
+
+enum class LogLevel : std::uint8_t {
+    Debug,
+    Info,
+    Warning,
+    Error,
+    Off
+};
+
+enum class LogCategory : std::uint8_t {
+    General,
+    Level,
+    Physics,
+    Door,
+    Gate,
+    Replay,
+    Resource,
+    Input,
+    COUNT
+};
+
+// One formatted message, copied whole through the ring buffer
+struct LogRecord {
+    static constexpr std::size_t MAX_TEXT = 240;   // longer messages end in "..."
+
+    LogLevel level;
+    LogCategory category;
+    std::uint8_t length;
+    char text[MAX_TEXT];
+};
+
+// Messages go into a fixed lock-free ring (bounded MPMC, Vyukov style) and
+// are written out by a background thread, so logging never waits on the
+// terminal. Any thread may log. If the ring is full the message is dropped
+// and counted rather than blocking the caller.
+class Logger {
+public:
+    static constexpr std::size_t CAPACITY = 1024;   // power of two
+
+    static Logger& instance();
+    static const char* categoryName(LogCategory category);
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        LogRecord record;
+    };
+
+    std::unique_ptr<std::array<Cell, CAPACITY>> m_cells;
+    alignas(64) std::atomic<std::size_t> m_enqueuePos;
+    alignas(64) std::size_t m_dequeuePos;   // writer thread only
+
+    std::atomic<std::uint8_t> m_minimumLevel;
+    std::atomic<std::uint32_t> m_categoryMask;
+    std::atomic<std::size_t> m_dropped;
+
+    // Set while the writer sleeps on an empty ring; push() then wakes it
+    std::atomic<bool> m_writerAsleep;
+
+    // For sleeping/waking the writer and for flush(). push() only takes it
+    // to wake a sleeping writer, i.e. for the first message after a lull.
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_written;
+    std::size_t m_writtenCount;   // records written, guarded by m_mutex
+    bool m_stopping;
+    std::thread m_thread;
+
+    Logger();
+    ~Logger();
+
+public:
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    // Runtime filters, on top of the compile-time one
+    bool isEnabled(LogLevel level, LogCategory category) const;
+    void setMinimumLevel(LogLevel level);
+    void setCategoryEnabled(LogCategory category, bool enabled);
+
+    void push(const LogRecord& record);
+
+    // Block until everything logged so far has been written
+    void flush();
+
+    std::size_t getDropped() const;
+
+private:
+    void run();
+    void wakeWriter();
+    bool isEmpty() const;   // writer thread only
+    bool pop(LogRecord& record);
+    static void write(const LogRecord& record);
+};
+
+// Builds one record in place from `<<`s and pushes it when destroyed
+class LogLine {
+private:
+    class Buffer : public std::streambuf {
+    private:
+        LogRecord& m_record;
+        bool m_truncated;
+
+    public:
+        explicit Buffer(LogRecord& record);
+        bool isTruncated() const;
+
+    protected:
+        int_type overflow(int_type ch) override;
+        std::streamsize xsputn(const char* text, std::streamsize count) override;
+    };
+
+    LogRecord m_record;
+    Buffer m_buffer;
+    std::ostream m_stream;
+
+public:
+    LogLine(LogLevel level, LogCategory category);
+    ~LogLine();
+
+    LogLine(const LogLine&) = delete;
+    LogLine& operator=(const LogLine&) = delete;
+
+    std::ostream& stream();
+};
+
+#define HOT_AND_COLD_LOG(level, category, message)                  \
+    do {                                                            \
+        if (Logger::instance().isEnabled(level, category)) {        \
+            LogLine logLine_(level, category);                      \
+            logLine_.stream() << message;                           \
+        }                                                           \
+    } while (0)
+
+// LOG_INFO(LogCategory::Door, "opened at " << x);
+#if HOT_AND_COLD_LOG_LEVEL <= 0
+#define LOG_DEBUG(category, message) HOT_AND_COLD_LOG(LogLevel::Debug, category, message)
+#else
+#define LOG_DEBUG(category, message) ((void)0)
+#endif
+
+#if HOT_AND_COLD_LOG_LEVEL <= 1
+#define LOG_INFO(category, message) HOT_AND_COLD_LOG(LogLevel::Info, category, message)
+#else
+#define LOG_INFO(category, message) ((void)0)
+#endif
+
+#if HOT_AND_COLD_LOG_LEVEL <= 2
+#define LOG_WARNING(category, message) HOT_AND_COLD_LOG(LogLevel::Warning, category, message)
+#else
+#define LOG_WARNING(category, message) ((void)0)
+#endif
+
+#if HOT_AND_COLD_LOG_LEVEL <= 3
+#define LOG_ERROR(category, message) HOT_AND_COLD_LOG(LogLevel::Error, category, message)
+#else
+#define LOG_ERROR(category, message) ((void)0)
+#endif
+
+#endif // LOG_H
@@ -0,0 +1,103 @@
+#ifndef LOGICNETWORK_H
+#define LOGICNETWORK_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Character.h"
+
+using TriggerId = std::uint32_t;
+using ActuatorId = std::uint32_t;
+
+enum class LogicOp : std::uint8_t {
+    Or,    // on while any input is on
+    And    // on while every input is on
+};
+
+// Trigger volumes (plates, door zones, switches) wired to actuators (gates,
+// doors). Volumes are indexed by the grid cells they overlap; a player only
+// rebuilds its candidate list when it moves into a different set of cells,
+// and is only tested against the few volumes in those cells. Actuators are
+// recomputed only when one of their triggers changes, and the ones that
+// flipped this tick are reported through getChangedActuators().
+class LogicNetwork {
+public:
+    static constexpr std::uint8_t ANY_PLAYER = 0xFF;
+    static constexpr std::size_t MAX_PLAYERS = 32;   // occupancy is a bitmask
+
+    static std::uint8_t kindMask(CharacterKind kind);
+
+    // Who stands on what; actuators and the per-player caches follow from it
+    struct State {
+        std::vector<std::uint32_t> occupants;   // by TriggerId
+    };
+
+private:
+    struct Trigger {
+        sf::FloatRect volume;
+        std::uint8_t acceptedKinds;   // kindMask() bits
+        std::uint32_t occupants;      // bit per player index
+        std::vector<ActuatorId> outputs;
+    };
+
+    struct Actuator {
+        LogicOp op;
+        std::uint32_t inputCount;
+        std::uint32_t activeInputs;
+        bool active;
+    };
+
+    struct CellRange {
+        int firstColumn, lastColumn;
+        int firstRow, lastRow;
+
+        bool operator==(const CellRange& other) const {
+            return firstColumn == other.firstColumn && lastColumn == other.lastColumn &&
+                   firstRow == other.firstRow && lastRow == other.lastRow;
+        }
+    };
+
+    static constexpr CellRange NO_CELLS{0, 0, 0, 0};     // dead players
+    static constexpr CellRange STALE_CELLS{1, 0, 1, 0};  // forces a candidate rebuild
+
+    struct PlayerState {
+        CellRange cells;
+        std::vector<TriggerId> candidates;   // triggers in those cells that accept this player
+    };
+
+    std::vector<Trigger> m_triggers;
+    std::vector<Actuator> m_actuators;
+    std::unordered_map<std::uint64_t, std::vector<TriggerId>> m_cellTriggers;
+    std::vector<PlayerState> m_playerStates;
+    std::vector<ActuatorId> m_changed;
+
+public:
+    TriggerId addTrigger(const sf::FloatRect& volume, std::uint8_t acceptedKinds = ANY_PLAYER);
+    ActuatorId addActuator(LogicOp op = LogicOp::Or);
+    void connect(TriggerId trigger, ActuatorId actuator);
+    void clear();
+    void reset();   // keep the wiring, forget who is standing where
+
+    State saveState() const;
+    // Carry on exactly as if saveState() had just been called, with
+    // `players` back where they were at that moment
+    void restoreState(const State& state, const std::vector<Character>& players);
+
+    // Once per tick, after movement. Dead players count as absent.
+    void update(const std::vector<Character>& players);
+
+    bool isActive(ActuatorId actuator) const;
+    bool isTriggered(TriggerId trigger) const;
+    const std::vector<ActuatorId>& getChangedActuators() const;   // during the last update()
+
+private:
+    static CellRange cellsUnder(const sf::FloatRect& rect);
+    static std::uint64_t cellKey(int column, int row);
+    static bool evaluate(const Actuator& actuator);
+
+    void collectCandidates(const CellRange& cells, std::uint8_t kind, std::vector<TriggerId>& out) const;
+    void setOccupied(TriggerId trigger, std::size_t player, bool inside);
+};
+
+#endif // LOGICNETWORK_H
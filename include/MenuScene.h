@@ -0,0 +1,37 @@
+#ifndef MENUSCENE_H
+#define MENUSCENE_H
+
+#include <vector>
+#include "Scene.h"
+#include "SceneStack.h"
+#include "TextBatch.h"
+
+// Main menu: pick a level (or quit). Keeps the highlighted level preloaded.
+class MenuScene : public Scene {
+private:
+    SceneStack& m_stack;
+    SceneContext& m_context;
+    int m_selectedOption;
+
+    static constexpr int LEVEL_COUNT = 5;
+    static constexpr int OPTION_COUNT = LEVEL_COUNT + 1;   // + Quit
+
+    // Built once; moving the selection only restyles two options and the arrow
+    TextBatch m_text;
+    std::vector<TextBatch::LabelId> m_optionLabels;
+    TextBatch::LabelId m_arrowLabel;
+
+public:
+    MenuScene(SceneStack& stack, SceneContext& context);
+
+    void handleEvent(const sf::Event& event) override;
+    void update(sf::Time elapsed) override;
+    void draw(sf::RenderTarget& target) override;
+    void onActivate() override;
+    bool isEventDriven() const override;
+
+private:
+    void select(int option);
+};
+
+#endif // MENUSCENE_H
@@ -0,0 +1,103 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+// Phase timers are compiled out unless HOT_AND_COLD_PROFILING is 1; the
+// CMake option and the Makefile's PROFILING=1 set it, and Profiler.cpp and
+// ProfilerHud.cpp are only built then. Without either, NDEBUG decides.
+#ifndef HOT_AND_COLD_PROFILING
+#ifdef NDEBUG
+#define HOT_AND_COLD_PROFILING 0
+#else
+#define HOT_AND_COLD_PROFILING 1
+#endif
+#endif
+
+// Timed parts of a frame. Movement..DoorsGates run inside Update, DrawBoard
+// and Display inside Draw.
+enum class Phase : std::size_t {
+    Frame,
+    Events,
+    Update,
+    Movement,
+    Death,
+    DoorsGates,
+    Draw,
+    DrawBoard,
+    Display,
+    COUNT
+};
+
+// Per-phase times for the last HISTORY frames in a fixed ring buffer.
+// A phase that runs several times in one frame (catch-up ticks) is summed.
+// One instance per thread, so simulations stepped on other threads never
+// mix into the game's numbers.
+class Profiler {
+public:
+    static constexpr std::size_t PHASE_COUNT = static_cast<std::size_t>(Phase::COUNT);
+    static constexpr std::size_t HISTORY = 240;
+
+    // Microseconds
+    struct Stats {
+        float current;
+        float average;
+        float p99;
+    };
+
+private:
+    std::array<float, PHASE_COUNT> m_current;
+    std::array<std::array<float, HISTORY>, PHASE_COUNT> m_history;
+    std::size_t m_head;    // slot the next finished frame goes into
+    std::size_t m_frames;  // filled slots, up to HISTORY
+
+    Profiler();
+
+public:
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    static Profiler& instance();
+    static const char* phaseName(Phase phase);
+
+    void add(Phase phase, float microseconds);
+    void endFrame();
+
+    Stats getStats(Phase phase) const;
+    float getSample(Phase phase, std::size_t framesAgo) const;  // 0 = last finished frame
+    std::size_t getFrameCount() const;
+};
+
+// Adds the time from construction to destruction to a phase
+class ScopedPhaseTimer {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Phase m_phase;
+    Clock::time_point m_start;
+
+public:
+    explicit ScopedPhaseTimer(Phase phase) : m_phase(phase), m_start(Clock::now()) {}
+
+    ~ScopedPhaseTimer() {
+        std::chrono::duration<float, std::micro> elapsed = Clock::now() - m_start;
+        Profiler::instance().add(m_phase, elapsed.count());
+    }
+
+    ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+};
+
+#if HOT_AND_COLD_PROFILING
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_PHASE(phase) ScopedPhaseTimer PROFILE_CONCAT(phaseTimer_, __LINE__)(phase)
+#define PROFILE_END_FRAME() Profiler::instance().endFrame()
+#else
+#define PROFILE_PHASE(phase) ((void)0)
+#define PROFILE_END_FRAME() ((void)0)
+#endif
+
+#endif // PROFILER_H
@@ -0,0 +1,30 @@
+#ifndef PROFILERHUD_H
+#define PROFILERHUD_H
+
+#include <SFML/Graphics.hpp>
+#include <string>
+
+// Debug overlay for the Profiler: current/average/p99 per phase and a
+// graph of recent frame times against the 60 FPS budget. Toggled with F3.
+class ProfilerHud : public sf::Drawable {
+private:
+    const sf::Font& m_font;
+    bool m_visible;
+
+    std::string m_table;
+    sf::VertexArray m_graph;
+
+public:
+    explicit ProfilerHud(const sf::Font& font);
+
+    void toggle();
+    bool isVisible() const;
+
+    // Refresh from the current thread's Profiler
+    void update();
+
+private:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+};
+
+#endif // PROFILERHUD_H
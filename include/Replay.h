@@ -0,0 +1,65 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Simulation.h"
+
+// Per-tick movement/jump inputs of both players for one attempt at a
+// level, plus the outcome it produced. Inputs are one byte per tick,
+// stored run-length encoded, so a minute of play is usually a few hundred
+// bytes. Replaying the inputs through a fresh Simulation must reproduce the
+// recorded outcome exactly.
+class Replay {
+public:
+    enum InputBits : std::uint8_t {
+        HOT_RIGHT  = 1 << 0,
+        HOT_LEFT   = 1 << 1,
+        HOT_JUMP   = 1 << 2,
+        COLD_RIGHT = 1 << 3,
+        COLD_LEFT  = 1 << 4,
+        COLD_JUMP  = 1 << 5
+    };
+
+    struct InputRun {
+        std::uint8_t inputs;
+        std::uint32_t ticks;
+    };
+
+    struct Outcome {
+        GameState state = GameState::Playing;
+        sf::Vector2f hotPosition;
+        sf::Vector2f coldPosition;
+        bool hotDead = false;
+        bool coldDead = false;
+    };
+
+private:
+    int m_level;
+    std::uint32_t m_tickCount;
+    std::vector<InputRun> m_runs;
+    Outcome m_outcome;
+
+public:
+    Replay();
+
+    void begin(int levelNumber);
+    void recordTick(std::uint8_t inputs);
+    void finish(const Simulation& simulation);
+
+    bool saveToFile(const std::string& path) const;
+    bool loadFromFile(const std::string& path);
+
+    int getLevel() const;
+    std::uint32_t getTickCount() const;
+    const std::vector<InputRun>& getRuns() const;
+    const Outcome& getOutcome() const;
+
+    static void applyInputs(Simulation& simulation, std::uint8_t inputs);
+    static std::uint8_t pendingJumps(const Simulation& simulation);   // jump bits not used yet
+    static Outcome captureOutcome(const Simulation& simulation);
+};
+
+#endif // REPLAY_H
@@ -0,0 +1,155 @@
+#ifndef RESOURCECACHE_H
+#define RESOURCECACHE_H
+
+#include <SFML/Graphics.hpp>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include "Log.h"
+
+template <typename Resource>
+struct ResourceFileLoader {
+    static bool load(Resource& resource, const std::string& path) { return resource.loadFromFile(path); }
+};
+
+// Process-wide cache handing out shared, read-only handles to loaded assets.
+// Each key is loaded once; later requests (e.g. every level restart) get the
+// same object back, so PNGs are decoded and uploaded to the GPU only once.
+// The cache keeps its own reference until purgeUnused() or clear().
+// Safe to use from several threads; a key being loaded by one thread makes
+// the others wait for that load instead of starting their own.
+template <typename Resource>
+class ResourceCache {
+public:
+    using Loader = std::function<bool(Resource&)>;
+
+private:
+    mutable std::mutex m_mutex;
+    std::condition_variable m_loaded;
+    std::map<std::string, std::shared_ptr<Resource>> m_resources;
+    std::set<std::string> m_loading;   // keys some thread is loading right now
+    std::size_t m_hits;
+    std::size_t m_misses;
+
+    ResourceCache() : m_hits(0), m_misses(0) {}
+
+public:
+    ResourceCache(const ResourceCache&) = delete;
+    ResourceCache& operator=(const ResourceCache&) = delete;
+
+    static ResourceCache& instance() {
+        static ResourceCache cache;
+        return cache;
+    }
+
+    // Load from a file path (Resource::loadFromFile unless specialised below)
+    std::shared_ptr<const Resource> get(const std::string& path) {
+        return get(path, [&path](Resource& resource) { return ResourceFileLoader<Resource>::load(resource, path); });
+    }
+
+    // Build with a custom loader on first use. A failed load is still cached
+    // (as an empty resource) so it is reported once and not retried; a loader
+    // that throws caches nothing and the exception reaches the caller.
+    std::shared_ptr<const Resource> get(const std::string& key, const Loader& loader) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;) {
+            auto it = m_resources.find(key);
+            if (it != m_resources.end()) {
+                ++m_hits;
+                return it->second;
+            }
+            if (m_loading.count(key) == 0) break;
+            m_loaded.wait(lock);
+        }
+
+        ++m_misses;
+        m_loading.insert(key);
+        lock.unlock();
+
+        // Loading runs unlocked so other keys aren't held up behind it
+        std::shared_ptr<Resource> resource;
+        try {
+            resource = std::make_shared<Resource>();
+            if (!loader(*resource)) {
+                LOG_WARNING(LogCategory::Resource, "could not load resource: " << key);
+            }
+        } catch (...) {
+            // Nothing cached; waiters wake up and try the load themselves
+            lock.lock();
+            m_loading.erase(key);
+            m_loaded.notify_all();
+            throw;
+        }
+
+        lock.lock();
+        m_loading.erase(key);
+        m_resources.emplace(key, resource);
+        m_loaded.notify_all();
+        return resource;
+    }
+
+    // Loaded, or being loaded by some thread right now
+    bool contains(const std::string& key) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_resources.count(key) != 0 || m_loading.count(key) != 0;
+    }
+
+    // Forget one entry; holders keep theirs
+    void release(const std::string& key) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_resources.erase(key);
+    }
+
+    // Drop entries nobody outside the cache is holding on to
+    void purgeUnused() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_resources.begin(); it != m_resources.end();) {
+            if (it->second.use_count() == 1) {
+                it = m_resources.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_resources.clear();
+    }
+
+    std::size_t getSize() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_resources.size();
+    }
+    std::size_t getHits() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_hits;
+    }
+    std::size_t getMisses() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_misses;
+    }
+};
+
+// Decoded pixels. Filled ahead of time by LevelPreloader's worker thread;
+// each image is dropped again once its texture has been created.
+using ImageCache = ResourceCache<sf::Image>;
+
+// A texture takes its pixels from ImageCache, so when the PNG was already
+// decoded off the main thread only the GPU upload is left to do here.
+template <>
+struct ResourceFileLoader<sf::Texture> {
+    static bool load(sf::Texture& texture, const std::string& path) {
+        std::shared_ptr<const sf::Image> image = ImageCache::instance().get(path);
+        ImageCache::instance().release(path);
+        return image->getSize().x > 0 && texture.loadFromImage(*image);
+    }
+};
+
+using TextureCache = ResourceCache<sf::Texture>;
+
+#endif // RESOURCECACHE_H
@@ -0,0 +1,32 @@
+#ifndef RESULTSSCENE_H
+#define RESULTSSCENE_H
+
+#include "Scene.h"
+#include "SceneStack.h"
+#include "TextBatch.h"
+
+class Game;
+
+// Win / game over panel drawn over the finished level. R restarts the level
+// underneath, M goes back to the menu and ESC quits.
+class ResultsScene : public Scene {
+private:
+    SceneStack& m_stack;
+    Game& m_game;   // the scene below; popped after this one
+    bool m_won;
+
+    // Laid out once; the panel never changes while it is up
+    sf::RectangleShape m_panel;
+    TextBatch m_text;
+
+public:
+    ResultsScene(SceneStack& stack, SceneContext& context, Game& game, bool won);
+
+    void handleEvent(const sf::Event& event) override;
+    void update(sf::Time elapsed) override;
+    void draw(sf::RenderTarget& target) override;
+    bool isOverlay() const override;
+    bool isEventDriven() const override;
+};
+
+#endif // RESULTSSCENE_H
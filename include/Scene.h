@@ -0,0 +1,54 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <SFML/Graphics.hpp>
+#include <string>
+
+class Controller;
+class LevelPreloader;
+
+// Long-lived things every scene shares. Owned by main; outlives all scenes.
+struct SceneContext {
+    sf::RenderWindow& window;
+    const sf::Font& font;
+    LevelPreloader& preloader;
+    Controller& controller;
+    std::string recordDirectory;   // empty = no replay recording
+    int lastWonLevel;              // set by Game on a win, read by the menu
+};
+
+// One screen of the game (menu, gameplay, results). Scenes live on a
+// SceneStack; only the top one gets events and updates.
+class Scene {
+private:
+    friend class SceneStack;
+    bool m_invalidated = true;
+
+public:
+    virtual ~Scene() = default;
+
+    virtual void handleEvent(const sf::Event& event) = 0;
+    virtual void update(sf::Time elapsed) = 0;   // once per frame
+    virtual void draw(sf::RenderTarget& target) = 0;
+
+    // Became the top scene again (pushed, or the one above it popped)
+    virtual void onActivate() {}
+
+    // Drawn over the scene below it instead of replacing it
+    virtual bool isOverlay() const { return false; }
+
+    // Only changes in response to input. While such a scene is on top the
+    // stack sleeps until the next event and redraws only after invalidate(),
+    // instead of updating and redrawing every frame.
+    virtual bool isEventDriven() const { return false; }
+
+    // Wake an event-driven scene this often even without input, for
+    // animations. Zero: wait for input only.
+    virtual sf::Time getAnimationInterval() const { return sf::Time::Zero; }
+
+protected:
+    // What an event-driven scene draws has changed
+    void invalidate() { m_invalidated = true; }
+};
+
+#endif // SCENE_H
@@ -0,0 +1,54 @@
+#ifndef SCENESTACK_H
+#define SCENESTACK_H
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
+#include "Scene.h"
+
+// Scenes sharing one window. Pushes and pops requested during a frame are
+// applied after it is displayed, so a scene can safely remove itself and the
+// next frame already shows the new scene; the window and GL context are
+// never recreated. While an event-driven scene is on top the loop blocks on
+// input and only redraws when something changed.
+class SceneStack {
+private:
+    struct Change {
+        enum class Type { Push, Pop, Clear } type;
+        std::unique_ptr<Scene> scene;   // Push only
+    };
+
+    std::vector<std::unique_ptr<Scene>> m_scenes;
+    std::vector<Change> m_pending;
+    bool m_redrawPending = true;   // scene switched, window resized, ...
+
+    // A run of frames with event-driven scenes on top, logged when it ends
+    // so idle CPU use can be checked
+    struct IdleStretch {
+        bool active = false;
+        sf::Clock wallClock;
+        sf::Time cpuStart;
+        unsigned int redraws = 0;
+    } m_idle;
+
+public:
+    void push(std::unique_ptr<Scene> scene);
+    void pop();
+    void clear();
+
+    bool isEmpty() const;
+
+    // Frame loop; returns when the window closes or the stack empties
+    void run(sf::RenderWindow& window);
+
+private:
+    bool applyPending();   // true if anything changed
+    void activateTop();
+    void dispatchEvent(sf::RenderWindow& window, const sf::Event& event);
+    void draw(sf::RenderWindow& window);
+
+    void beginIdleStretch();
+    void endIdleStretch();
+};
+
+#endif // SCENESTACK_H
@@ -0,0 +1,140 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Board.h"
+#include "Character.h"
+#include "Doors.h"
+#include "Gates.h"
+#include "LogicNetwork.h"
+
+enum class GameState {
+    Playing,
+    Won,
+    Lost
+};
+
+// Index of an entity in one of Simulation's arrays. Unlike a pointer it
+// stays valid when the array grows, and the type parameter stops a door
+// handle from indexing the players.
+template <typename Entity>
+struct EntityHandle {
+    static constexpr std::uint32_t NONE = 0xFFFFFFFFu;
+    std::uint32_t index = NONE;
+
+    bool isValid() const { return index != NONE; }
+    bool operator==(const EntityHandle& other) const { return index == other.index; }
+};
+
+using PlayerHandle = EntityHandle<Character>;
+using DoorHandle = EntityHandle<Doors>;
+using GateHandle = EntityHandle<Gates>;
+
+// Windowless game rules: board, players, doors, gates and win/lose state.
+// Nothing in here touches a window or a GL context, so it can be stepped
+// headless. Game wraps it for input and rendering.
+class Simulation {
+public:
+    // One update() is one tick; the physics constants are per tick
+    static constexpr int TICKS_PER_SECOND = 60;
+
+    // Everything a level changes while it is played, by entity index
+    struct Snapshot {
+        std::vector<Character::State> players;
+        std::vector<Doors::State> doors;
+        std::vector<Gates::State> gates;
+        LogicNetwork::State logic;
+        GameState gameState;
+    };
+
+private:
+    std::unique_ptr<Board> m_board;
+
+    // Entities by value, contiguous; rebuilt from scratch on every load
+    std::vector<Character> m_players;
+    std::vector<Doors> m_doors;
+    std::vector<Gates> m_gates;
+
+    PlayerHandle m_hotPlayer;
+    PlayerHandle m_coldPlayer;
+
+    // Plates and door zones -> gates and doors; see wireLogic()
+    struct ActuatorTarget {
+        GateHandle gate;   // exactly one of the two is valid
+        DoorHandle door;
+    };
+    LogicNetwork m_logic;
+    std::vector<ActuatorTarget> m_actuatorTargets;   // by ActuatorId
+    std::vector<DoorHandle> m_raisingDoors;          // doors whose opener is at them
+    std::vector<sf::FloatRect> m_obstacles;          // closed gates, rebuilt each tick
+
+    Snapshot m_initialState;   // taken right after loading, for restart()
+
+    GameState m_gameState;
+    int m_currentLevel;
+    bool m_winLogged;   // per world, so several can step on different threads
+
+public:
+    Simulation();
+    explicit Simulation(int levelNumber);
+    ~Simulation();
+
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+
+    static std::string getLevelPath(int levelNumber);
+
+    // `board` is the level's map already parsed elsewhere (see
+    // LevelPreloader); without one it is read from disk here
+    void initializeLevel(int levelNumber, std::unique_ptr<Board> board = nullptr);
+    void loadLevel(const std::string& levelFile);
+
+    // Back to the freshly loaded level without touching disk or the GPU
+    void restart();
+    Snapshot saveSnapshot() const;
+    void restoreSnapshot(const Snapshot& snapshot);   // same level only
+    void update();
+    void checkDeath();
+    bool checkWin();
+
+    GameState getGameState() const;
+    int getCurrentLevel() const;
+
+    LogicNetwork& getLogic();
+
+    Board& getBoard();
+    const Board& getBoard() const;
+    std::vector<Character>& getPlayers();
+    const std::vector<Character>& getPlayers() const;
+    std::vector<Doors>& getDoors();
+    const std::vector<Doors>& getDoors() const;
+    std::vector<Gates>& getGates();
+    const std::vector<Gates>& getGates() const;
+
+    // nullptr for an invalid handle; don't hold on across a level load
+    Character* getPlayer(PlayerHandle handle);
+    const Character* getPlayer(PlayerHandle handle) const;
+    Doors* getDoor(DoorHandle handle);
+    const Doors* getDoor(DoorHandle handle) const;
+    Gates* getGate(GateHandle handle);
+    const Gates* getGate(GateHandle handle) const;
+    Character* getHotPlayer();
+    const Character* getHotPlayer() const;
+    Character* getColdPlayer();
+    const Character* getColdPlayer() const;
+
+private:
+    void setupLevel(std::unique_ptr<Board> board);
+    PlayerHandle addPlayer(CharacterKind kind, const sf::Vector2f& position);
+    DoorHandle addDoor(DoorKind kind, const sf::Vector2f& position);
+    GateHandle addGate(const sf::Vector2f& position, const std::vector<sf::Vector2f>& plates);
+    void wireLogic();
+    void applyActuator(ActuatorId actuator);
+    void cleanup();
+};
+
+#endif // SIMULATION_H
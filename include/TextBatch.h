@@ -0,0 +1,65 @@
+#ifndef TEXTBATCH_H
+#define TEXTBATCH_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Retained text for a whole screen. Labels are laid out into glyph quads
+// once and redrawn from cached vertices every frame; only changing a label
+// (text, position, colour, weight) re-lays them out. Each character size
+// has its own glyph texture in sf::Font, so there is one draw call per size
+// in use, however many labels there are.
+class TextBatch : public sf::Drawable {
+public:
+    using LabelId = std::size_t;
+
+    enum class Align : std::uint8_t {
+        Left,     // position is the top-left, like sf::Text
+        Center    // position.x is the horizontal centre
+    };
+
+private:
+    struct Label {
+        std::string text;   // UTF-8
+        sf::Vector2f position;
+        unsigned int size;
+        sf::Color color;
+        bool bold;
+        Align align;
+    };
+
+    struct Layer {
+        unsigned int size;
+        sf::VertexArray vertices;
+    };
+
+    const sf::Font& m_font;
+    std::vector<Label> m_labels;
+
+    // Built lazily by draw() after a change
+    mutable std::vector<Layer> m_layers;
+    mutable bool m_dirty;
+
+public:
+    explicit TextBatch(const sf::Font& font);
+
+    LabelId add(const std::string& text, const sf::Vector2f& position, unsigned int size,
+                sf::Color color = sf::Color::White, bool bold = false, Align align = Align::Left);
+
+    // No-ops (and no re-layout) when the value is unchanged
+    void setText(LabelId label, const std::string& text);
+    void setPosition(LabelId label, const sf::Vector2f& position);
+    void setColor(LabelId label, sf::Color color);
+    void setBold(LabelId label, bool bold);
+
+    std::size_t getDrawCallCount() const;
+
+private:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    void rebuild() const;
+    void appendLabel(const Label& label, sf::VertexArray& vertices) const;
+};
+
+#endif // TEXTBATCH_H
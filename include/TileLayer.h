@@ -0,0 +1,51 @@
+#ifndef TILELAYER_H
+#define TILELAYER_H
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include "Board.h"
+
+// Board geometry over the board's tile atlas, drawn in a single call.
+// Only the tiles inside the camera's view are turned into vertices, so the
+// cost follows screen size rather than level size. The vertices are rebuilt
+// only when the visible range of grid cells changes.
+class TileLayer : public sf::Drawable {
+private:
+    // Grid cells currently in m_vertices, [first, last)
+    struct CellRange {
+        int firstColumn, lastColumn;
+        int firstRow, lastRow;
+
+        bool operator==(const CellRange& other) const {
+            return firstColumn == other.firstColumn && lastColumn == other.lastColumn &&
+                   firstRow == other.firstRow && lastRow == other.lastRow;
+        }
+    };
+
+    const Board* m_board;
+    const sf::Texture* m_atlas;
+
+    // How each tile ID is drawn, looked up once per build()
+    std::array<sf::IntRect, Tiles::COUNT> m_texRects;
+    std::array<sf::Color, Tiles::COUNT> m_colors;
+
+    sf::VertexArray m_vertices;
+    CellRange m_range;
+    std::size_t m_tileCount;
+
+public:
+    TileLayer();
+
+    void build(const Board& board);
+
+    // Rebuild for the part of the world inside `visibleArea` (world pixels)
+    void cull(const sf::FloatRect& visibleArea);
+
+    std::size_t getTileCount() const;   // tiles in the last culled range
+
+private:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    void appendTile(const sf::FloatRect& rect, const sf::IntRect& texRect, sf::Color color);
+};
+
+#endif // TILELAYER_H
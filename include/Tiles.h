@@ -0,0 +1,77 @@
+#ifndef TILES_H
+#define TILES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Compact tile IDs. Level files store the string codes from the table
+// below; Board keeps one TileId byte per cell and classifies tiles by
+// looking up their flags instead of comparing strings.
+// No SFML here so standalone tools (analyze_level) can share it.
+using TileId = std::uint8_t;
+
+enum TileFlags : std::uint8_t {
+    TILE_SOLID  = 1 << 0,
+    TILE_LAVA   = 1 << 1,
+    TILE_WATER  = 1 << 2,
+    TILE_GOO    = 1 << 3,
+    TILE_HAZARD = TILE_LAVA | TILE_WATER | TILE_GOO
+};
+
+struct TileProperties {
+    std::string_view code;        // as written in level files
+    std::uint8_t flags;           // TileFlags
+    bool textured;                // has data/board_textures/<code>.png
+    std::uint32_t fallbackColor;  // 0xRRGGBB, drawn when the texture is missing
+    char symbol;                  // for text dumps of a level
+    const char* description;
+};
+
+namespace Tiles {
+
+inline constexpr TileProperties PROPERTIES[] = {
+    {"0",   0,          false, 0x000000, '.', "Empty space"},
+    {"2",   TILE_LAVA,  true,  0xFF5000, 'L', "LAVA (kills cold)"},
+    {"3",   TILE_WATER, true,  0x0078FF, 'W', "WATER (kills hot)"},
+    {"4",   TILE_GOO,   true,  0x32FF32, 'G', "GOO (kills both)"},
+    {"100", TILE_SOLID, true,  0x464646, '#', "Wall type 1"},
+    {"111", TILE_SOLID, true,  0x464646, '#', "Wall type 2"},
+    {"112", TILE_SOLID, true,  0x464646, '#', "Wall/Platform"},
+    {"113", TILE_SOLID, true,  0x464646, '#', "Wall/Platform"},
+    {"114", TILE_SOLID, true,  0x464646, '#', "Wall/Platform"},
+    {"121", TILE_SOLID, true,  0x464646, '#', "Wall/Platform"},
+    {"122", TILE_SOLID, true,  0x464646, '#', "Wall/Platform"},
+    {"123", TILE_SOLID, true,  0x464646, '#', "Wall/Platform"},
+    {"124", TILE_SOLID, true,  0x464646, '#', "Wall/Platform"},
+    // Any code not listed above: solid, drawn with the fallback colour
+    {"?",   TILE_SOLID, false, 0x464646, '#', "Unknown (treated as wall)"}
+};
+
+inline constexpr std::size_t COUNT = sizeof(PROPERTIES) / sizeof(PROPERTIES[0]);
+
+inline constexpr TileId EMPTY   = 0;
+inline constexpr TileId LAVA    = 1;
+inline constexpr TileId WATER   = 2;
+inline constexpr TileId GOO     = 3;
+inline constexpr TileId UNKNOWN = static_cast<TileId>(COUNT - 1);
+
+inline TileId parseTileCode(std::string_view code) {
+    if (code.empty()) return EMPTY;
+    for (std::size_t i = 0; i < UNKNOWN; ++i) {
+        if (PROPERTIES[i].code == code) return static_cast<TileId>(i);
+    }
+    return UNKNOWN;
+}
+
+inline const TileProperties& properties(TileId id) {
+    return PROPERTIES[id < COUNT ? id : UNKNOWN];
+}
+
+inline bool hasFlag(TileId id, TileFlags flag) {
+    return (properties(id).flags & flag) != 0;
+}
+
+}
+
+#endif // TILES_H